@@ -0,0 +1,91 @@
+//
+//  AppEnvironment.swift
+//  RickAndMorty-Combine
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// Dependencies shared by the launch path and the screens, so work started during launch
+/// (e.g. the first character fetch) is picked up by the view controllers instead of repeated.
+final class AppEnvironment {
+    static let shared = AppEnvironment()
+    
+    let graph = RelationshipGraph()
+    let offline = OfflineSupport.standard()
+    let rowHeightCache = RowHeightCache()
+    /// Bytes received by the character services, for the per-refresh transfer metric.
+    let transferMeter = TransferMeter()
+    /// Set from the `RM_NETWORK_*` launch environment variables in debug builds, to replay,
+    /// record or shape the app's traffic, see `NetworkHarness`.
+    let networkHarness: NetworkHarness?
+    /// Every service and image load goes through it.
+    let session: URLSession
+    let episodes: ResourceRepository<Episode>
+    /// Every in-memory cache registers here, so they are trimmed together on memory pressure.
+    let cacheBudget = CacheBudgetManager()
+    let experimentPlatform: ExperimentPlatform
+    let experiments: ExperimentConfigStore
+    /// Buffers events until `LaunchOrchestrator` starts flushing them, once Apptimize is started.
+    let analytics: Analytics
+    
+    init(experimentPlatform: ExperimentPlatform = ApptimizePlatform()) {
+        self.experimentPlatform = experimentPlatform
+        self.experiments = ExperimentConfigStore(source: experimentPlatform.variables)
+        self.analytics = Analytics(sink: TrackingAnalyticsSink(platform: experimentPlatform))
+        let networkHarness = AppEnvironment.makeNetworkHarness()
+        let session = networkHarness?.makeSession() ?? .shared
+        self.networkHarness = networkHarness
+        self.session = session
+        self.episodes = ResourceRepository(service: ResourceApiService(session: session))
+        
+        cacheBudget.register(rowHeightCache.cache, name: "row-heights", priority: .low, bytesPerEntry: 96)
+        cacheBudget.register(episodes.cache, name: "episodes", priority: .normal, bytesPerEntry: 4096)
+        ImageCache.shared.register(with: cacheBudget)
+        cacheBudget.startMonitoringMemoryPressure()
+    }
+    
+    private static func makeNetworkHarness() -> NetworkHarness? {
+        #if DEBUG
+        do {
+            return try NetworkHarness(environment: ProcessInfo.processInfo.environment)
+        } catch {
+            assertionFailure("Invalid RM_NETWORK_* environment: \(error)")
+        }
+        #endif
+        return nil
+    }
+    
+    /// The list only needs a few fields per character; behind the `usesGraphQLTransport` experiment
+    /// they are fetched through GraphQL, with episode ids added for the "First seen in" row and
+    /// species for the species filter and sections. The experiment is read per request, as
+    /// Apptimize starts after the first fetch.
+    private(set) lazy var characterService: CharacterApiServiceProtocol = ExperimentCharacterService(
+        experiments: experiments,
+        rest: CharacterApiService(session: session, meter: transferMeter),
+        graphQL: GraphQLCharacterService(session: session, projection: CharacterProjection.list.adding(.species, .episodeIDs), meter: transferMeter)
+    )
+    /// Refreshes of the cached catalogue only fetch new ids and a couple of pages, see `CatalogueDeltaSync`.
+    private(set) lazy var characterRepository = CharacterRepository(
+        service: characterService,
+        offline: offline,
+        deltaSync: CatalogueDeltaSync(service: characterService,
+                                      characters: ResourceApiService(session: session, meter: transferMeter),
+                                      store: offline.store,
+                                      meter: transferMeter),
+        graph: graph
+    )
+    private(set) lazy var characterViewModel = CharacterViewModel(
+        repository: characterRepository,
+        reachability: offline.reachability,
+        analytics: analytics
+    )
+    private(set) lazy var tuner = PerformanceTuner(experiments: experiments,
+                                                     viewModel: characterViewModel,
+                                                     cacheBudget: cacheBudget,
+                                                     syncEvents: characterRepository.syncEvents,
+                                                     analytics: analytics)
+    private(set) lazy var firstSeenResolver = FirstSeenResolver(episodes: EpisodeRepository(resources: episodes, graph: graph), graph: graph)
+}
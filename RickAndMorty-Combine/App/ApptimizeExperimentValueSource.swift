@@ -0,0 +1,40 @@
+//
+//  ApptimizeExperimentValueSource.swift
+//  RickAndMorty-Combine
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import Apptimize
+import RickAndMortyCore
+
+/// Reads experiment variables from `ApptimizeVariable`.
+///
+/// `make…(name:default…:)` declares the variable on first use and returns the existing one
+/// afterwards, so every read doubles as the declaration the SDK needs before it can run a test.
+/// Values change when `ApptimizeMetadataStateChangedNotification` fires.
+final class ApptimizeExperimentValueSource: ExperimentValueSource {
+    var changes: AnyPublisher<Void, Never> {
+        return NotificationCenter.default
+            .publisher(for: Notification.Name(ApptimizeMetadataStateChangedNotification))
+            .map { _ in () }
+            .eraseToAnyPublisher()
+    }
+    
+    func value(of variable: ExperimentVariable<Bool>) -> Bool {
+        return ApptimizeVariable.makeBool(name: variable.name, defaultBool: variable.defaultValue)?.boolValue ?? variable.defaultValue
+    }
+    
+    func value(of variable: ExperimentVariable<Int>) -> Int {
+        return ApptimizeVariable.makeInteger(name: variable.name, defaultInteger: variable.defaultValue)?.integerValue ?? variable.defaultValue
+    }
+    
+    func value(of variable: ExperimentVariable<Double>) -> Double {
+        return ApptimizeVariable.makeDouble(name: variable.name, defaultDouble: variable.defaultValue)?.doubleValue ?? variable.defaultValue
+    }
+    
+    func value(of variable: ExperimentVariable<String>) -> String {
+        return ApptimizeVariable.makeString(name: variable.name, defaultString: variable.defaultValue)?.stringValue ?? variable.defaultValue
+    }
+}
@@ -0,0 +1,58 @@
+//
+//  ApptimizePlatform.swift
+//  RickAndMorty-Combine
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import Apptimize
+import RickAndMortyCore
+
+/// `ExperimentPlatform` backed by the Apptimize SDK. The only file besides
+/// `ApptimizeExperimentValueSource` that talks to `Apptimize` directly.
+final class ApptimizePlatform: ExperimentPlatform {
+    let variables: ExperimentValueSource = ApptimizeExperimentValueSource()
+    
+    var initialized: AnyPublisher<Void, Never> {
+        return NotificationCenter.default
+            .publisher(for: Notification.Name(ApptimizeInitializedNotification))
+            .map { _ in () }
+            .eraseToAnyPublisher()
+    }
+    
+    var isOffline: Bool {
+        return Apptimize.isOffline()
+    }
+    
+    /// Must be called on the main thread, as the SDK requires.
+    func start(applicationKey: String, waitingForMetadataUpTo timeout: TimeInterval) {
+        let options: [String: Any] = [
+            ApptimizeServerRegionOption: ApptimizeServerRegionEUCS,
+            ApptimizeDelayUntilTestsAreAvailableOption: Int(timeout * 1000)
+        ]
+        Apptimize.start(withApplicationKey: applicationKey, options: options)
+    }
+    
+    func setOffline(_ offline: Bool) {
+        Apptimize.setOffline(offline)
+    }
+    
+    func track(_ event: String) {
+        Apptimize.track(event)
+    }
+    
+    func track(_ event: String, value: Double) {
+        Apptimize.track(event, value: value)
+    }
+    
+    func isFeatureFlagOn(_ name: String) -> Bool {
+        return Apptimize.isFeatureFlag(on: name)
+    }
+    
+    func runTest(_ name: String, baseline: @escaping () -> Void, variants: [String: () -> Void]) {
+        // The SDK may keep the blocks and run them later, so they must escape.
+        let codeBlocks = variants.map { ApptimizeCodeBlock(name: $0.key, andBlock: $0.value) }
+        Apptimize.runTest(name, withBaseline: baseline, andApptimizeCodeBlocks: codeBlocks)
+    }
+}
@@ -0,0 +1,124 @@
+//
+//  LaunchOrchestrator.swift
+//  RickAndMorty-Combine
+//
+//  Created by agent on 19/10/26.
+//
+
+import UIKit
+import os
+import RickAndMortyCore
+
+/// Splits launch into a critical phase (first character fetch, cached rows) and a deferred,
+/// low-priority phase for third-party SDKs that runs once the first row is on screen.
+///
+/// Pass `-DeferApptimizeStart NO` as a launch argument to start Apptimize synchronously in
+/// `didFinishLaunching` again, e.g. to compare launch-to-first-row between both modes.
+///
+/// Launch phases are recorded by `StartupTracer.shared`; once the first avatar is on screen the
+/// trace is logged and written to `startup-trace.json` in the caches directory.
+final class LaunchOrchestrator {
+    static let shared = LaunchOrchestrator()
+    
+    /// Upper bound on how long the deferred phase waits for the first row.
+    private static let deferredPhaseTimeout: TimeInterval = 3
+    private static let log = Logger(subsystem: "RickAndMorty-Combine", category: "Launch")
+    
+    private let environment: AppEnvironment
+    private let tracer: StartupTracer
+    private let defersApptimizeStart: Bool
+    private var deferredPhaseStarted = false
+    private var initialization: AnyCancellable?
+    
+    private var firstRowSeen = false
+    private var traceReported = false
+    
+    private(set) var apptimizeInitializedAt: Date?
+    
+    init(environment: AppEnvironment = .shared, tracer: StartupTracer = .shared, defaults: UserDefaults = .standard) {
+        self.environment = environment
+        self.tracer = tracer
+        defaults.register(defaults: ["DeferApptimizeStart": true])
+        self.defersApptimizeStart = defaults.bool(forKey: "DeferApptimizeStart")
+    }
+    
+    func applicationDidFinishLaunching() {
+        tracer.mark(.didFinishLaunching)
+        
+        // Critical phase: page 1 is served from the local store right away and refreshed from
+        // the network; CharactersViewController binds to the same view model. Apptimize has not
+        // started yet, so the fetch uses the default tuning; `PerformanceTuner` fetches again if
+        // the variant that arrives later asks for a larger first page.
+        environment.tuner.start()
+        environment.characterViewModel.fetchCharacters()
+        
+        if defersApptimizeStart {
+            DispatchQueue.main.asyncAfter(deadline: .now() + LaunchOrchestrator.deferredPhaseTimeout) { [weak self] in
+                self?.startDeferredPhase()
+            }
+        } else {
+            startApptimize()
+        }
+    }
+    
+    func firstRowDisplayed() {
+        guard !firstRowSeen else { return }
+        firstRowSeen = true
+        tracer.mark(.firstRowRendered)
+        
+        // Wait for the main run loop to go idle in the default mode (about to sleep, with no
+        // pending sources or timers), so the deferred phase never competes with the first layout
+        // pass. A scroll runs the loop in the tracking mode, which this observer ignores.
+        let observer = CFRunLoopObserverCreateWithHandler(nil, CFRunLoopActivity.beforeWaiting.rawValue, false, 0) { [weak self] (observer, _) in
+            CFRunLoopRemoveObserver(CFRunLoopGetMain(), observer, .defaultMode)
+            self?.startDeferredPhase()
+        }
+        CFRunLoopAddObserver(CFRunLoopGetMain(), observer, .defaultMode)
+    }
+    
+    func firstAvatarDisplayed() {
+        guard !traceReported else { return }
+        traceReported = true
+        tracer.mark(.firstAvatarRendered)
+        reportStartupTrace()
+    }
+    
+    private func startDeferredPhase() {
+        guard defersApptimizeStart, !deferredPhaseStarted else { return }
+        deferredPhaseStarted = true
+        startApptimize()
+    }
+    
+    /// Analytics are sent through the SDK and experiment values read from it, so both wait for
+    /// it to report being initialized. Events recorded until then wait in the analytics buffer.
+    private func startApptimize() {
+        initialization = environment.experimentPlatform.initialized
+            .first()
+            .receive(on: DispatchQueue.main)
+            .sink { [weak self] in
+                guard let self = self else { return }
+                self.apptimizeInitializedAt = Date()
+                self.environment.experiments.reload()
+                self.environment.analytics.start()
+            }
+        
+        let apptimizeAppKey = "AYYbCdsJHaYtZFPfwvtHpAqueLrbzVg"
+        // Never block setup waiting for experiments to download.
+        environment.experimentPlatform.start(applicationKey: apptimizeAppKey, waitingForMetadataUpTo: 0)
+    }
+    
+    private func reportStartupTrace() {
+        let revision = Bundle.main.infoDictionary?["CFBundleVersion"] as? String
+        let trace = tracer.trace(revision: revision)
+        let phases = StartupPhase.allCases.compactMap { phase in
+            trace[phase].map { "\(phase.rawValue)=\(Int($0))ms" }
+        }
+        LaunchOrchestrator.log.info("\(phases.joined(separator: " "), privacy: .public) (Apptimize deferred: \(self.defersApptimizeStart, privacy: .public))")
+        
+        DispatchQueue.global(qos: .utility).async {
+            guard let directory = OfflineSupport.defaultDirectory, let data = try? trace.encoded() else { return }
+            try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+            try? data.write(to: directory.appendingPathComponent("startup-trace.json"), options: .atomic)
+        }
+    }
+}
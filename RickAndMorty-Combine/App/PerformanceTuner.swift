@@ -0,0 +1,78 @@
+//
+//  PerformanceTuner.swift
+//  RickAndMorty-Combine
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// Applies the pipeline tuning knobs of `ExperimentConfig` (page size, prefetch depth, image cache
+/// size, search debounce) as soon as a new config arrives, and tags analytics with the variant
+/// so latency and memory histograms are reported per combination of knobs.
+///
+/// Prefetch depth is read by `CharactersViewController` straight from the config.
+///
+/// Every sample also holds the caches to their `CacheBudgetManager` budget, and every catalogue
+/// delta refresh reports how much it downloaded.
+final class PerformanceTuner {
+    /// How often the memory footprint is sampled into the analytics histogram.
+    private static let memorySamplingInterval: TimeInterval = 10
+    
+    private let experiments: ExperimentConfigStore
+    private let viewModel: CharacterViewModel
+    private let imageCache: ImageCache
+    private let cacheBudget: CacheBudgetManager
+    private let syncEvents: AnyPublisher<CharacterSyncCoordinator.Event, Never>
+    private let analytics: Analytics
+    private var bindings = Set<AnyCancellable>()
+    private var memorySampler: Timer?
+    
+    init(experiments: ExperimentConfigStore,
+         viewModel: CharacterViewModel,
+         imageCache: ImageCache = .shared,
+         cacheBudget: CacheBudgetManager,
+         syncEvents: AnyPublisher<CharacterSyncCoordinator.Event, Never>,
+         analytics: Analytics) {
+        self.experiments = experiments
+        self.viewModel = viewModel
+        self.imageCache = imageCache
+        self.cacheBudget = cacheBudget
+        self.syncEvents = syncEvents
+        self.analytics = analytics
+    }
+    
+    func start() {
+        guard bindings.isEmpty else { return }
+        
+        experiments.updates.sink { [unowned self] (config) in
+            // The launch fetch ran with the previous page size; a variant arriving later with a
+            // larger one needs the missing rows.
+            let needsMoreRows = config.pageSize > self.viewModel.pageSize
+            self.viewModel.apply(config)
+            if needsMoreRows {
+                self.viewModel.fetchCharacters()
+            }
+            self.imageCache.megabytes = config.imageCacheMegabytes
+            self.analytics.setVariant(config.tuningVariant)
+        }
+        .store(in: &bindings)
+        
+        syncEvents.sink { [analytics] (event) in
+            guard case .refreshed(let refresh) = event, let transfer = refresh.transfer else { return }
+            analytics.record(.refreshTransfer, value: Double(transfer.bytes) / 1024)
+        }
+        .store(in: &bindings)
+        
+        let timer = Timer(timeInterval: PerformanceTuner.memorySamplingInterval, repeats: true) { [analytics, cacheBudget] _ in
+            cacheBudget.enforceBudget()
+            analytics.record(.cacheFootprint, value: Double(cacheBudget.totalBytes) / (1024 * 1024))
+            guard let bytes = MemoryFootprint.currentBytes else { return }
+            analytics.record(.memoryFootprint, value: Double(bytes) / (1024 * 1024))
+        }
+        timer.tolerance = 2
+        RunLoop.main.add(timer, forMode: .common)
+        memorySampler = timer
+    }
+}
@@ -0,0 +1,55 @@
+//
+//  ScrollHitchDetector.swift
+//  RickAndMorty-Combine
+//
+//  Created by agent on 19/10/26.
+//
+
+import UIKit
+import RickAndMortyCore
+
+/// Times every frame with a display link while a scroll view is moving and feeds them to a
+/// `HitchMonitor`. When the scroll ends, its hitch time ratio is recorded in analytics.
+final class ScrollHitchDetector {
+    private let monitor: HitchMonitor
+    private let analytics: Analytics
+    private var displayLink: CADisplayLink?
+    private var lastTimestamp: CFTimeInterval?
+    
+    /// Called on the main thread with the report of each scroll, e.g. by `HitchOverlayView`.
+    var onReport: ((HitchReport) -> Void)?
+    
+    init(monitor: HitchMonitor, analytics: Analytics) {
+        self.monitor = monitor
+        self.analytics = analytics
+    }
+    
+    func scrollingBegan() {
+        guard displayLink == nil else { return }
+        monitor.reset()
+        // The display link retains its target until it is invalidated in `scrollingEnded()`.
+        let displayLink = CADisplayLink(target: self, selector: #selector(frameDidRender(_:)))
+        displayLink.add(to: .main, forMode: .common)
+        self.displayLink = displayLink
+    }
+    
+    func scrollingEnded() {
+        guard let displayLink = displayLink else { return }
+        displayLink.invalidate()
+        self.displayLink = nil
+        lastTimestamp = nil
+    
+        let report = monitor.takeReport()
+        guard report.frames > 0 else { return }
+        analytics.record(.hitchTimeRatio, value: report.hitchTimeRatio)
+        onReport?(report)
+    }
+    
+    /// A frame lasts from the previous callback to this one; it was due one refresh interval later.
+    @objc private func frameDidRender(_ displayLink: CADisplayLink) {
+        if let lastTimestamp = lastTimestamp {
+            monitor.recordFrame(start: lastTimestamp, end: displayLink.timestamp, expected: displayLink.duration)
+        }
+        lastTimestamp = displayLink.timestamp
+    }
+}
@@ -6,19 +6,18 @@
 //
 
 import UIKit
-import Apptimize
 
 @main
 class AppDelegate: UIResponder, UIApplicationDelegate {
     func application(_ application: UIApplication, didFinishLaunchingWithOptions launchOptions: [UIApplication.LaunchOptionsKey: Any]?) -> Bool {
-
-        // If you're using the in code setup (Apptimize startApptimizeWithApplicationKey)
-        // Add the following ApptimizeOptions to setup
-        let apptimizeAppKey = "AYYbCdsJHaYtZFPfwvtHpAqueLrbzVg"
-        let apptimizeOptions = [ApptimizeServerRegionOption : ApptimizeServerRegionEUCS]
-        Apptimize.start(withApplicationKey: apptimizeAppKey, options: apptimizeOptions)
+        // Apptimize is started by the orchestrator's deferred phase, once the first row is on screen.
+        LaunchOrchestrator.shared.applicationDidFinishLaunching()
         
         return true
     }
+    
+    func applicationDidReceiveMemoryWarning(_ application: UIApplication) {
+        AppEnvironment.shared.cacheBudget.trim(for: .warning)
+    }
 }
 
@@ -53,6 +53,10 @@ class SceneDelegate: UIResponder, UIWindowSceneDelegate {
         // Called as the scene transitions from the foreground to the background.
         // Use this method to save data, release shared resources, and store enough scene-specific state information
         // to restore the scene back to its current state.
+        AppEnvironment.shared.analytics.flush()
+        // Saves from the last second are still pending; the app may be suspended before they are written.
+        AppEnvironment.shared.offline.store.flush()
+        AppEnvironment.shared.cacheBudget.trim(for: .background)
     }
 
 
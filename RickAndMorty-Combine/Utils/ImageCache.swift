@@ -0,0 +1,42 @@
+//
+//  ImageCache.swift
+//  RickAndMorty-Combine
+//
+//  Created by agent on 19/10/26.
+//
+
+import UIKit
+import RickAndMortyCore
+
+/// Decoded avatars, bounded by their decoded size in bytes.
+final class ImageCache {
+    static let shared = ImageCache()
+    
+    private let cache = MemoryCache<URL, UIImage>(costLimit: 50 * 1024 * 1024)
+    
+    var megabytes: Int {
+        get { return cache.costLimit / (1024 * 1024) }
+        set {
+            cache.costLimit = newValue * 1024 * 1024
+            cache.trim(toCost: cache.costLimit)
+        }
+    }
+    
+    var totalCost: Int {
+        return cache.totalCost
+    }
+    
+    /// Avatars are what the list shows: trimmed last, after every cheaper cache.
+    func register(with budget: CacheBudgetManager) {
+        budget.register(cache, name: "avatars", priority: .high)
+    }
+    
+    func image(for url: URL) -> UIImage? {
+        return cache.value(forKey: url)
+    }
+    
+    func insert(_ image: UIImage, for url: URL) {
+        let cost = image.cgImage.map { $0.bytesPerRow * $0.height } ?? 0
+        cache.setValue(image, forKey: url, cost: cost)
+    }
+}
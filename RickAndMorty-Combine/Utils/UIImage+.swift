@@ -7,16 +7,29 @@
 
 import Foundation
 import UIKit
+import RickAndMortyCore
 
 extension UIImageView {
-    func load(url: URL) {
-        let task = URLSession.shared.dataTask(with: url) {(data, response, error) in
-            guard let data = data else {
+    /// - Parameter session: `AppEnvironment.shared.session` in the app, so avatars can be replayed and shaped too.
+    func load(url: URL, session: URLSession = .shared, completion: (() -> Void)? = nil) {
+        if let image = ImageCache.shared.image(for: url) {
+            self.image = image
+            completion?()
+            return
+        }
+        let task = session.dataTask(with: url) {(data, response, error) in
+            guard let data = data, let image = UIImage(data: data) else {
                 return
             }
+            ImageCache.shared.insert(image, for: url)
             // maybe try dispatch to main
             DispatchQueue.main.async {
-                self.image = UIImage(data: data)
+                // `UIImage(data:)` is lazy: the bitmap is decompressed on the main thread when this
+                // run loop pass commits, in the frame this interval falls in.
+                HitchMonitor.shared.measure(.imageDecode) {
+                    self.image = image
+                }
+                completion?()
             }
         }
         task.resume()
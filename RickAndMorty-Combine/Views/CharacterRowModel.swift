@@ -0,0 +1,77 @@
+//
+//  CharacterRowModel.swift
+//  RickAndMorty-Combine
+//
+//  Created by agent on 19/10/26.
+//
+
+import UIKit
+import RickAndMortyCore
+
+/// Display model of a `CharacterTableViewCell`: formatted text, parsed avatar URL, status color
+/// and row height, all computed off the main thread by `RowModelBuilder`.
+struct CharacterRowModel {
+    /// Measures rows the way `CharacterTableViewCell.xib` lays them out, without Auto Layout.
+    struct Metrics {
+        let nameFont: UIFont
+        let valueFont = UIFont.systemFont(ofSize: 17)
+        let captionFont = UIFont.systemFont(ofSize: 14)
+        
+        /// Label heights plus the xib's fixed metrics from `CharacterTableViewCell.Layout`.
+        func height(for row: CharacterRow) -> CGFloat {
+            typealias Layout = CharacterTableViewCell.Layout
+            let name = Metrics.singleLineHeight(of: row.name, font: nameFont)
+            let status = Metrics.singleLineHeight(of: row.statusText, font: valueFont)
+            let group = ceil(captionFont.lineHeight) + Layout.captionSpacing + ceil(valueFont.lineHeight)
+            return Layout.containerInset + Layout.avatarHeight
+                + Layout.nameSpacing + name + Layout.statusSpacing + status
+                + Layout.detailsSpacing + group + Layout.groupSpacing + group
+                + Layout.bottomInset + Layout.containerInset
+        }
+        
+        /// The name and status labels are single line and truncate: only the font decides their height.
+        private static func singleLineHeight(of text: String, font: UIFont) -> CGFloat {
+            let bounds = (text as NSString).boundingRect(with: CGSize(width: CGFloat.greatestFiniteMagnitude, height: .greatestFiniteMagnitude),
+                                                         options: [.usesLineFragmentOrigin, .usesFontLeading],
+                                                         attributes: [.font: font],
+                                                         context: nil)
+            return ceil(min(bounds.height, font.lineHeight))
+        }
+    }
+    
+    let row: CharacterRow
+    let statusColor: UIColor
+    let height: CGFloat
+    
+    var character: Character {
+        return row.character
+    }
+    
+    /// Builds models with the cell's fonts at `contentSizeCategory`. Fonts are resolved once, on
+    /// the calling (main) thread; heights come from `heightCache` when the row was measured
+    /// at that size before, and are measured and stored on the builder's queue otherwise.
+    static func builder(for contentSizeCategory: UIContentSizeCategory, heightCache: RowHeightCache) -> RowModelBuilder<CharacterRowModel> {
+        let traits = UITraitCollection(preferredContentSizeCategory: contentSizeCategory)
+        let metrics = Metrics(nameFont: UIFont.preferredFont(forTextStyle: .title1, compatibleWith: traits))
+        let category = contentSizeCategory.rawValue
+        
+        return RowModelBuilder { row in
+            if let height = heightCache.height(forID: row.id, category: category) {
+                return CharacterRowModel(row: row, height: CGFloat(height))
+            }
+            let height = metrics.height(for: row)
+            heightCache.setHeight(Double(height), forID: row.id, category: category)
+            return CharacterRowModel(row: row, height: height)
+        }
+    }
+    
+    init(row: CharacterRow, height: CGFloat) {
+        self.row = row
+        self.height = height
+        switch row.status {
+        case .alive: self.statusColor = .systemGreen
+        case .dead: self.statusColor = .systemRed
+        case .unknown: self.statusColor = .secondaryLabel
+        }
+    }
+}
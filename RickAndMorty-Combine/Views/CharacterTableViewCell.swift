@@ -6,6 +6,7 @@
 //
 
 import UIKit
+import RickAndMortyCore
 
 class CharacterTableViewCell: UITableViewCell, Identifiable {
 
@@ -21,6 +22,26 @@ class CharacterTableViewCell: UITableViewCell, Identifiable {
     @IBOutlet weak var lastKnownLocationValueLabel: UILabel!
     @IBOutlet weak var firstSeenInValueLabel: UILabel!
     
+    /// Fixed vertical metrics of `CharacterTableViewCell.xib`, for measuring rows without Auto
+    /// Layout (see `CharacterRowModel.Metrics`). Debug builds check them against the xib.
+    enum Layout {
+        /// Between the content view and the rounded container, top and bottom.
+        static let containerInset: CGFloat = 8
+        static let avatarHeight: CGFloat = 180
+        /// Avatar to name.
+        static let nameSpacing: CGFloat = 8
+        /// Name to status.
+        static let statusSpacing: CGFloat = 4
+        /// Status to the first caption/value group.
+        static let detailsSpacing: CGFloat = 8
+        /// Between a caption and its value.
+        static let captionSpacing: CGFloat = 8
+        /// Between the two caption/value groups.
+        static let groupSpacing: CGFloat = 16
+        /// Last value to the container's bottom.
+        static let bottomInset: CGFloat = 16
+    }
+    
     static var reuseIdentifier: String {
         return String(describing: self)
     }
@@ -30,23 +51,57 @@ class CharacterTableViewCell: UITableViewCell, Identifiable {
         
         containerView.layer.cornerRadius = 5.0
         containerView.layer.masksToBounds = true
+        #if DEBUG
+        assertLayoutMatchesXib()
+        #endif
     }
 
     override func setSelected(_ selected: Bool, animated: Bool) {
         super.setSelected(selected, animated: animated)
     }
     
-    func configure(with character: Character) {
-        self.characterName.text = character.name
-        self.characterStatus.text = "\(character.status) - \(character.gender)"
-        if let locationName = character.location.name {
+    /// Only assignments: everything shown was formatted when the row model was built.
+    func configure(with model: CharacterRowModel, firstSeenIn episodeName: String?) {
+        self.characterName.text = model.row.name
+        self.characterStatus.text = model.row.statusText
+        self.characterStatus.textColor = model.statusColor
+        if let locationName = model.row.locationName {
             self.lastKnownLocationValueLabel.text = locationName
         }
-        if let originName = character.location.name {
-            self.firstSeenInValueLabel.text = originName
+        setFirstSeenIn(episodeName)
+        if let url = model.row.imageURL {
+            self.characterImageView?.load(url: url, session: AppEnvironment.shared.session) {
+                LaunchOrchestrator.shared.firstAvatarDisplayed()
+            }
         }
-        if let url = URL(string: character.image) {
-            self.characterImageView?.load(url: url)
+    }
+    
+    func setFirstSeenIn(_ episodeName: String?) {
+        self.firstSeenInValueLabel.text = episodeName ?? "-"
+    }
+    
+    #if DEBUG
+    private func assertLayoutMatchesXib() {
+        // Constant of the constraint in `view` that pins `attribute` of `item`.
+        func constant(in view: UIView, _ item: UIView, _ attribute: NSLayoutConstraint.Attribute) -> CGFloat? {
+            return view.constraints.first {
+                ($0.firstItem === item && $0.firstAttribute == attribute) || ($0.secondItem === item && $0.secondAttribute == attribute)
+            }?.constant
         }
+        let group = lastKnownLocationValueLabel.superview as? UIStackView
+        let details = group?.superview as? UIStackView
+        let xib: [(CGFloat?, CGFloat)] = [
+            (constant(in: contentView, containerView, .top), Layout.containerInset),
+            (constant(in: contentView, containerView, .bottom), Layout.containerInset),
+            (constant(in: characterImageView, characterImageView, .height), Layout.avatarHeight),
+            (constant(in: containerView, characterName, .top), Layout.nameSpacing),
+            (constant(in: containerView, characterStatus, .top), Layout.statusSpacing),
+            (details.flatMap { constant(in: containerView, $0, .top) }, Layout.detailsSpacing),
+            (group?.spacing, Layout.captionSpacing),
+            (details?.spacing, Layout.groupSpacing),
+            (details.flatMap { constant(in: containerView, $0, .bottom) }, Layout.bottomInset)
+        ]
+        assert(xib.allSatisfy { $0.0 == $0.1 }, "CharacterTableViewCell.xib no longer matches CharacterTableViewCell.Layout")
     }
+    #endif
 }
@@ -7,35 +7,135 @@
 
 import UIKit
 import Combine
+import RickAndMortyCore
 
 class CharactersViewController: UIViewController {
+    /// Larger changes reload the table instead of animating every row.
+    private static let maxAnimatedChanges = 200
     
     @IBOutlet weak var tableView: UITableView!
     
     let searchController = UISearchController(searchResultsController: nil)
     
-    private let viewModel: CharacterViewModel = CharacterViewModel()
+    private let viewModel = AppEnvironment.shared.characterViewModel
+    private let firstSeenResolver = AppEnvironment.shared.firstSeenResolver
+    private let experiments = AppEnvironment.shared.experiments
+    private let analytics = AppEnvironment.shared.analytics
+    private let hitchMonitor = HitchMonitor.shared
+    private lazy var hitchDetector = ScrollHitchDetector(monitor: hitchMonitor, analytics: analytics)
+    private var deepestDisplayedRow = -1
+    private let heightCache = AppEnvironment.shared.rowHeightCache
+    private lazy var rowBuilder = makeRowBuilder(for: UIApplication.shared.preferredContentSizeCategory)
+    /// Row models in the order of `list.characters`; `list.sections` orders them on screen.
+    private var rows = [CharacterRowModel]()
+    private var list = CharacterSectionedList.empty
+    /// Index of each section's first row in the whole list, for scroll depth and prefetching.
+    private var sectionStarts = [Int]()
+    private var displayedRows = [UInt32]()
+    private var rowsSubscription: AnyCancellable?
+    private let filterBar = UIStackView()
+    private var filterButtons = [CharacterFacet: UIButton]()
     var bindings = Set<AnyCancellable>()
     
     override func viewDidLoad() {
         super.viewDidLoad()
+        StartupTracer.shared.mark(.charactersViewLoaded)
 
         setupTableView()
+        setupFilterBar()
+        setupLayoutMenu()
         setupSearchController()
         setupSearchBarListeners()
         bindViewModel()
-        viewModel.fetchCharacters()
+        #if DEBUG
+        setupHitchOverlay()
+        #endif
+    }
+    
+    override func traitCollectionDidChange(_ previousTraitCollection: UITraitCollection?) {
+        super.traitCollectionDidChange(previousTraitCollection)
+        let category = traitCollection.preferredContentSizeCategory
+        guard category != previousTraitCollection?.preferredContentSizeCategory else { return }
+        // Label heights depend on the Dynamic Type size: rebuild every row with the new fonts.
+        rowBuilder = makeRowBuilder(for: category)
+        bindRows()
+    }
+    
+    /// The builder's model cache is registered with the cache budget; the registration goes away
+    /// with the builder when the content size category changes.
+    private func makeRowBuilder(for category: UIContentSizeCategory) -> RowModelBuilder<CharacterRowModel> {
+        let builder = CharacterRowModel.builder(for: category, heightCache: heightCache)
+        AppEnvironment.shared.cacheBudget.register(builder.cache, name: "row-models", priority: .normal, bytesPerEntry: 1024)
+        return builder
     }
     
     private func setupTableView() {
         tableView.delegate = self
         tableView.dataSource = self
+        tableView.prefetchDataSource = self
         let nib = UINib(nibName: "CharacterTableViewCell", bundle: nil)
         tableView.register(nib, forCellReuseIdentifier: CharacterTableViewCell.reuseIdentifier)
     }
     
+    /// One chip per facet; its menu lists the facet's values with live counts.
+    private func setupFilterBar() {
+        filterBar.axis = .horizontal
+        filterBar.distribution = .fillEqually
+        filterBar.spacing = 8
+        filterBar.layoutMargins = UIEdgeInsets(top: 8, left: 16, bottom: 8, right: 16)
+        filterBar.isLayoutMarginsRelativeArrangement = true
+        for facet in CharacterFacet.allCases {
+            let button = UIButton(type: .system)
+            button.setTitle(facet.rawValue.capitalized, for: .normal)
+            button.showsMenuAsPrimaryAction = true
+            filterButtons[facet] = button
+            filterBar.addArrangedSubview(button)
+        }
+        filterBar.frame = CGRect(x: 0, y: 0, width: tableView.bounds.width, height: 48)
+        tableView.tableHeaderView = filterBar
+    }
+    
+    private func setupLayoutMenu() {
+        navigationItem.rightBarButtonItem = UIBarButtonItem(title: "Sort",
+                                                            image: UIImage(systemName: "arrow.up.arrow.down"),
+                                                            primaryAction: nil,
+                                                            menu: nil)
+    }
+    
+    private func layoutMenu(for layout: CharacterListLayout) -> UIMenu {
+        let orders = CharacterSortOrder.allCases.map { (order) in
+            UIAction(title: order.title, state: layout.order == order ? .on : .off) { [unowned self] (_) in
+                self.viewModel.layout.send(CharacterListLayout(order: order, grouping: layout.grouping))
+            }
+        }
+        let groupings = CharacterGrouping.allCases.map { (grouping) in
+            UIAction(title: grouping.title, state: layout.grouping == grouping ? .on : .off) { [unowned self] (_) in
+                self.viewModel.layout.send(CharacterListLayout(order: layout.order, grouping: grouping))
+            }
+        }
+        return UIMenu(children: [
+            UIMenu(title: "Sort by", options: .displayInline, children: orders),
+            UIMenu(title: "Group by", options: .displayInline, children: groupings)
+        ])
+    }
+    
+    #if DEBUG
+    private func setupHitchOverlay() {
+        let overlay = HitchOverlayView()
+        view.addSubview(overlay)
+        NSLayoutConstraint.activate([
+            overlay.trailingAnchor.constraint(equalTo: view.safeAreaLayoutGuide.trailingAnchor, constant: -8),
+            overlay.bottomAnchor.constraint(equalTo: view.safeAreaLayoutGuide.bottomAnchor, constant: -8)
+        ])
+        hitchDetector.onReport = { [weak overlay] (report) in
+            overlay?.show(report)
+        }
+    }
+    #endif
+    
     private func setupSearchController() {
         searchController.searchResultsUpdater = self
+        searchController.delegate = self
         searchController.obscuresBackgroundDuringPresentation = false
         searchController.searchBar.placeholder = "Search..."
         navigationItem.searchController = searchController
@@ -53,17 +153,111 @@ class CharactersViewController: UIViewController {
             .sink { [unowned self] (str) in
                 self.viewModel.searchText.send(str)
             }.store(in: &bindings)
-        viewModel.characters.sink { [unowned self] (_) in
-            self.tableView.reloadData()
-        }.store(in: &bindings)
     }
 
     
     private func bindViewModel() {
-        viewModel.characters.sink { [unowned self] (_) in
+        bindRows()
+        
+        viewModel.facetCounts.sink { [unowned self] (counts) in
+            self.updateFilterMenus(with: counts)
+        }
+        .store(in: &bindings)
+        
+        viewModel.layout.sink { [unowned self] (layout) in
+            self.navigationItem.rightBarButtonItem?.menu = self.layoutMenu(for: layout)
+        }
+        .store(in: &bindings)
+        
+        experiments.updates.dropFirst().sink { [unowned self] (_) in
             self.tableView.reloadData()
         }
         .store(in: &bindings)
+        
+        firstSeenResolver.resolved.sink { [unowned self] (characterIDs) in
+            self.updateFirstSeen(for: characterIDs)
+        }
+        .store(in: &bindings)
+    }
+    
+    /// Rows are built off the main thread whenever the characters or their layout change; the
+    /// table only ever shows `rows`, so it never indexes into characters whose rows are not ready yet.
+    private func bindRows() {
+        rowsSubscription = rowBuilder.rows(for: viewModel.sectionedCharacters, characters: \.characters).sink { [unowned self] (list, rows) in
+            self.apply(list, rows: rows)
+            // Resolve the whole page up front: one episode request covers every row of it.
+            if self.experiments.current.showsFirstSeenIn {
+                self.firstSeenResolver.resolve(rows.map(\.character))
+            }
+        }
+    }
+    
+    /// Animates the sectioned difference from the list on screen, reloading rows whose character
+    /// was refreshed in place. An unchanged list (new row heights), a large change or an offscreen
+    /// table reloads everything instead.
+    private func apply(_ list: CharacterSectionedList, rows: [CharacterRowModel]) {
+        hitchMonitor.measure(.diffApply) {
+            apply(list, rows: rows, difference: list.difference(from: self.list))
+        }
+    }
+    
+    private func apply(_ list: CharacterSectionedList, rows: [CharacterRowModel], difference: SectionedDifference) {
+        let update = {
+            self.list = list
+            self.rows = rows
+            self.sectionStarts = list.sections.reduce(into: [0]) { $0.append($0[$0.count - 1] + $1.rows.count) }
+            self.displayedRows = list.sections.flatMap(\.rows)
+        }
+        guard tableView.window != nil, !difference.isEmpty, difference.changeCount <= CharactersViewController.maxAnimatedChanges else {
+            update()
+            tableView.reloadData()
+            return
+        }
+        tableView.performBatchUpdates {
+            update()
+            self.tableView.deleteSections(difference.deletedSections, with: .fade)
+            self.tableView.insertSections(difference.insertedSections, with: .fade)
+            self.tableView.deleteRows(at: difference.deletedRows.map { IndexPath(row: $0.row, section: $0.section) }, with: .fade)
+            self.tableView.insertRows(at: difference.insertedRows.map { IndexPath(row: $0.row, section: $0.section) }, with: .fade)
+            self.tableView.reloadRows(at: difference.reloadedRows.map { IndexPath(row: $0.row, section: $0.section) }, with: .none)
+        }
+    }
+    
+    private func row(at indexPath: IndexPath) -> CharacterRowModel? {
+        guard indexPath.section < list.sections.count,
+              indexPath.row < list.sections[indexPath.section].rows.count else { return nil }
+        let position = list.sections[indexPath.section].row(at: indexPath.row)
+        return position < rows.count ? rows[position] : nil
+    }
+    
+    /// Position of `indexPath` in the whole list, across sections.
+    private func displayIndex(of indexPath: IndexPath) -> Int {
+        return indexPath.section < sectionStarts.count ? sectionStarts[indexPath.section] + indexPath.row : indexPath.row
+    }
+    
+    private func updateFilterMenus(with counts: [CharacterFacet: [FacetValueCount]]) {
+        let filter = viewModel.filter.value
+        for (facet, button) in filterButtons {
+            let title = facet.rawValue.capitalized
+            let actions = (counts[facet] ?? []).map { (item) in
+                UIAction(title: "\(item.value.isEmpty ? "none" : item.value) (\(item.count))",
+                         state: filter.isSelected(item.value, in: facet) ? .on : .off) { [unowned self] (_) in
+                    self.viewModel.toggleFilter(item.value, in: facet)
+                }
+            }
+            button.menu = UIMenu(title: title, children: actions)
+            let selected = filter.selections[facet]?.count ?? 0
+            button.setTitle(selected == 0 ? title : "\(title) · \(selected)", for: .normal)
+        }
+    }
+    
+    private func updateFirstSeen(for characterIDs: Set<Int>) {
+        for indexPath in tableView.indexPathsForVisibleRows ?? [] {
+            guard let character = row(at: indexPath)?.character,
+                  characterIDs.contains(character.id),
+                  let cell = tableView.cellForRow(at: indexPath) as? CharacterTableViewCell else { continue }
+            cell.setFirstSeenIn(firstSeenResolver.episodeName(for: character))
+        }
     }
     
 
@@ -80,21 +274,126 @@ class CharactersViewController: UIViewController {
 }
 
 extension CharactersViewController: UITableViewDelegate, UITableViewDataSource {
+    func tableView(_ tableView: UITableView, willDisplay cell: UITableViewCell, forRowAt indexPath: IndexPath) {
+        LaunchOrchestrator.shared.firstRowDisplayed()
+        let index = displayIndex(of: indexPath)
+        if index > deepestDisplayedRow {
+            deepestDisplayedRow = index
+            analytics.record(.scrollDepth, value: Double(index))
+        }
+    }
+    
+    // Heights come from the row models, measured off the main thread, so the table never runs
+    // Auto Layout to size a cell.
+    func tableView(_ tableView: UITableView, heightForRowAt indexPath: IndexPath) -> CGFloat {
+        return row(at: indexPath)?.height ?? UITableView.automaticDimension
+    }
+    
+    func tableView(_ tableView: UITableView, estimatedHeightForRowAt indexPath: IndexPath) -> CGFloat {
+        if let row = row(at: indexPath) {
+            return row.height
+        }
+        let category = traitCollection.preferredContentSizeCategory.rawValue
+        return heightCache.averageHeight(category: category).map { CGFloat($0) } ?? UITableView.automaticDimension
+    }
+    
+    func numberOfSections(in tableView: UITableView) -> Int {
+        return list.sections.count
+    }
+    
+    func tableView(_ tableView: UITableView, titleForHeaderInSection section: Int) -> String? {
+        return list.sections[section].title
+    }
+    
     func tableView(_ tableView: UITableView, numberOfRowsInSection section: Int) -> Int {
-        return viewModel.characters.value.count
+        return list.sections[section].rows.count
     }
     
     func tableView(_ tableView: UITableView, cellForRowAt indexPath: IndexPath) -> UITableViewCell {
         let cell = tableView.dequeueReusableCell(withIdentifier: CharacterTableViewCell.reuseIdentifier, for: indexPath) as! CharacterTableViewCell
         
-        let character = viewModel.characters.value[indexPath.row]
-        cell.configure(with: character)
+        guard let model = row(at: indexPath) else { return cell }
+        let showsFirstSeenIn = experiments.current.showsFirstSeenIn
+        let firstSeenIn = showsFirstSeenIn ? firstSeenResolver.episodeName(for: model.character) : nil
+        
+        let start = DispatchTime.now().uptimeNanoseconds
+        hitchMonitor.measure(.cellConfigure) {
+            cell.configure(with: model, firstSeenIn: firstSeenIn)
+        }
+        analytics.record(.cellConfigureTime, value: Double(DispatchTime.now().uptimeNanoseconds - start) / 1000)
+        
+        if showsFirstSeenIn {
+            analytics.record(firstSeenIn == nil ? .firstSeenCacheMiss : .firstSeenCacheHit)
+            if firstSeenIn == nil {
+                firstSeenResolver.resolve([model.character])
+            }
+        }
         
         return cell
     }
 }
 
+// MARK: - UIScrollViewDelegate
+// Frames are only timed while the list moves, so the hitch time ratio is per second of scrolling.
+extension CharactersViewController {
+    func scrollViewWillBeginDragging(_ scrollView: UIScrollView) {
+        hitchDetector.scrollingBegan()
+    }
+    
+    func scrollViewDidEndDragging(_ scrollView: UIScrollView, willDecelerate decelerate: Bool) {
+        if !decelerate {
+            hitchDetector.scrollingEnded()
+        }
+    }
+    
+    func scrollViewDidEndDecelerating(_ scrollView: UIScrollView) {
+        hitchDetector.scrollingEnded()
+    }
+}
+
+extension CharactersViewController: UITableViewDataSourcePrefetching {
+    func tableView(_ tableView: UITableView, prefetchRowsAt indexPaths: [IndexPath]) {
+        let config = experiments.current
+        guard config.showsFirstSeenIn, config.prefetchesFirstSeenIn else { return }
+        // Prefetch depth extends UIKit's prefetch window further down the list.
+        let indexes = indexPaths.map(displayIndex(of:))
+        let deepest = indexes.max() ?? 0
+        let prefetched = Set(indexes).union(deepest..<(deepest + config.prefetchDepth + 1))
+        firstSeenResolver.resolve(prefetched.sorted()
+            .filter { $0 < displayedRows.count && Int(displayedRows[$0]) < rows.count }
+            .map { rows[Int(displayedRows[$0])].character })
+    }
+}
+
+extension CharactersViewController: UISearchControllerDelegate {
+    func willPresentSearchController(_ searchController: UISearchController) {
+        viewModel.prepareSearch()
+    }
+}
+
 extension CharactersViewController: UISearchResultsUpdating {
     func updateSearchResults(for searchController: UISearchController) {
     }
 }
+
+private extension CharacterSortOrder {
+    var title: String {
+        switch self {
+        case .original: return "Default"
+        case .name: return "Name"
+        case .status: return "Status"
+        case .episodeCount: return "Episode count"
+        case .firstAppearance: return "First appearance"
+        }
+    }
+}
+
+private extension CharacterGrouping {
+    var title: String {
+        switch self {
+        case .none: return "None"
+        case .species: return "Species"
+        case .location: return "Location"
+        }
+    }
+}
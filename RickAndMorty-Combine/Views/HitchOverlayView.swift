@@ -0,0 +1,48 @@
+//
+//  HitchOverlayView.swift
+//  RickAndMorty-Combine
+//
+//  Created by agent on 19/10/26.
+//
+
+import UIKit
+import RickAndMortyCore
+
+/// Debug readout of the last scroll: hitch time ratio, p95 frame time and the work blamed for
+/// the hitches. Ignores touches, so it can sit on top of the list.
+final class HitchOverlayView: UILabel {
+    override init(frame: CGRect) {
+        super.init(frame: frame)
+        font = .monospacedDigitSystemFont(ofSize: 11, weight: .medium)
+        textColor = .white
+        backgroundColor = UIColor.black.withAlphaComponent(0.6)
+        numberOfLines = 0
+        textAlignment = .center
+        layer.cornerRadius = 6
+        layer.masksToBounds = true
+        isUserInteractionEnabled = false
+        translatesAutoresizingMaskIntoConstraints = false
+        show(HitchReport())
+    }
+    
+    required init?(coder: NSCoder) {
+        fatalError("init(coder:) has not been implemented")
+    }
+    
+    override var intrinsicContentSize: CGSize {
+        let size = super.intrinsicContentSize
+        return CGSize(width: size.width + 12, height: size.height + 8)
+    }
+    
+    func show(_ report: HitchReport) {
+        var lines = [
+            String(format: "hitches %.1f ms/s (%d/%d)", report.hitchTimeRatio, report.hitches, report.frames),
+            String(format: "p95 frame %.1f ms", report.histogram.quantile(0.95))
+        ]
+        lines += report.attribution.sorted { $0.value > $1.value }.map { (work, milliseconds) in
+            String(format: "%@ %.1f ms", work.rawValue, milliseconds)
+        }
+        text = lines.joined(separator: "\n")
+        textColor = report.hitchTimeRatio > 10 ? .systemRed : report.hitchTimeRatio > 5 ? .systemYellow : .white
+    }
+}
@@ -0,0 +1,38 @@
+// swift-tools-version:5.3
+
+import PackageDescription
+
+let openCombine: [Target.Dependency] = ["OpenCombine", "OpenCombineDispatch", "OpenCombineFoundation"].map {
+    .product(name: $0, package: "OpenCombine", condition: .when(platforms: [.linux]))
+}
+
+let package = Package(
+    name: "RickAndMortyKit",
+    platforms: [
+        .iOS(.v14),
+        .macOS(.v11)
+    ],
+    products: [
+        .library(name: "RickAndMortyCore", targets: ["RickAndMortyCore"]),
+        .executable(name: "Benchmarks", targets: ["Benchmarks"])
+    ],
+    dependencies: [
+        .package(url: "https://github.com/OpenCombine/OpenCombine.git", from: "0.14.0"),
+        .package(url: "https://github.com/apple/swift-atomics.git", from: "1.0.0")
+    ],
+    targets: [
+        .target(
+            name: "RickAndMortyCore",
+            dependencies: openCombine + [.product(name: "Atomics", package: "swift-atomics")]
+        ),
+        .target(
+            name: "Benchmarks",
+            dependencies: ["RickAndMortyCore"],
+            resources: [.copy("Fixtures")]
+        ),
+        .testTarget(
+            name: "RickAndMortyCoreTests",
+            dependencies: ["RickAndMortyCore"]
+        )
+    ]
+)
@@ -0,0 +1,86 @@
+//
+//  Benchmark.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+struct Benchmark {
+    let suite: String
+    let name: String
+    /// Logical items (records, queries, rows...) handled by a single iteration.
+    let items: Int
+    /// Payload bytes handled by a single iteration, `0` when not meaningful.
+    let bytes: Int
+    /// Extra counters sampled once the benchmark finished, e.g. requests served by the stub server.
+    let counters: () -> [String: Double]
+    let body: () throws -> Void
+
+    var identifier: String {
+        return "\(suite)/\(name)"
+    }
+
+    init(suite: String,
+         name: String,
+         items: Int = 1,
+         bytes: Int = 0,
+         counters: @escaping () -> [String: Double] = { [:] },
+         body: @escaping () throws -> Void) {
+        self.suite = suite
+        self.name = name
+        self.items = items
+        self.bytes = bytes
+        self.counters = counters
+        self.body = body
+    }
+}
+
+struct BenchmarkConfiguration {
+    var warmupIterations = 3
+    var minIterations = 10
+    var maxIterations = 100_000
+    var minDuration: TimeInterval = 0.5
+    var filter: String?
+}
+
+final class BenchmarkRunner {
+    private let configuration: BenchmarkConfiguration
+
+    init(configuration: BenchmarkConfiguration) {
+        self.configuration = configuration
+    }
+
+    func shouldRun(_ benchmark: Benchmark) -> Bool {
+        guard let filter = configuration.filter, !filter.isEmpty else { return true }
+        return benchmark.identifier.range(of: filter, options: .caseInsensitive) != nil
+    }
+
+    func run(_ benchmark: Benchmark) throws -> BenchmarkResult {
+        for _ in 0..<configuration.warmupIterations {
+            try benchmark.body()
+        }
+
+        var samples = [UInt64]()
+        samples.reserveCapacity(configuration.minIterations)
+
+        let minDuration = UInt64(configuration.minDuration * 1_000_000_000)
+        let start = DispatchTime.now().uptimeNanoseconds
+
+        while samples.count < configuration.minIterations
+                || (DispatchTime.now().uptimeNanoseconds - start < minDuration && samples.count < configuration.maxIterations) {
+            let begin = DispatchTime.now().uptimeNanoseconds
+            try benchmark.body()
+            samples.append(DispatchTime.now().uptimeNanoseconds - begin)
+        }
+
+        return BenchmarkResult(benchmark: benchmark, samples: samples)
+    }
+}
+
+/// Keeps the optimizer from discarding work whose result is otherwise unused.
+@inline(never)
+func blackHole<T>(_ value: T) {
+    withExtendedLifetime(value) {}
+}
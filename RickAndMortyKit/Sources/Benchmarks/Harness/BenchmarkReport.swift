@@ -0,0 +1,92 @@
+//
+//  BenchmarkReport.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+struct BenchmarkResult: Codable {
+    let suite: String
+    let name: String
+    let iterations: Int
+    let minNanoseconds: UInt64
+    let medianNanoseconds: UInt64
+    let meanNanoseconds: Double
+    let p90Nanoseconds: UInt64
+    let p99Nanoseconds: UInt64
+    let maxNanoseconds: UInt64
+    let standardDeviationNanoseconds: Double
+    let itemsPerSecond: Double
+    let bytesPerSecond: Double?
+    let counters: [String: Double]
+
+    init(benchmark: Benchmark, samples: [UInt64]) {
+        let sorted = samples.sorted()
+        let count = Double(sorted.count)
+        let mean = sorted.reduce(0.0) { $0 + Double($1) } / count
+        let variance = sorted.reduce(0.0) { $0 + pow(Double($1) - mean, 2) } / count
+        let median = sorted[sorted.count / 2]
+
+        func percentile(_ p: Double) -> UInt64 {
+            let index = Int((p * Double(sorted.count - 1)).rounded(.up))
+            return sorted[min(index, sorted.count - 1)]
+        }
+
+        suite = benchmark.suite
+        name = benchmark.name
+        iterations = sorted.count
+        minNanoseconds = sorted[0]
+        medianNanoseconds = median
+        meanNanoseconds = mean
+        p90Nanoseconds = percentile(0.90)
+        p99Nanoseconds = percentile(0.99)
+        maxNanoseconds = sorted[sorted.count - 1]
+        standardDeviationNanoseconds = variance.squareRoot()
+        itemsPerSecond = Double(benchmark.items) / (Double(median) / 1_000_000_000)
+        bytesPerSecond = benchmark.bytes > 0 ? Double(benchmark.bytes) / (Double(median) / 1_000_000_000) : nil
+        counters = benchmark.counters()
+    }
+
+    var summary: String {
+        let median = String(format: "%.3f", Double(medianNanoseconds) / 1_000_000)
+        let p99 = String(format: "%.3f", Double(p99Nanoseconds) / 1_000_000)
+        let throughput = String(format: "%.0f", itemsPerSecond)
+        return "\(suite)/\(name): median \(median) ms, p99 \(p99) ms, \(throughput) items/s (\(iterations) iterations)"
+    }
+}
+
+struct BenchmarkReport: Codable {
+    struct Host: Codable {
+        let operatingSystem: String
+        let processorCount: Int
+        let physicalMemory: UInt64
+    }
+
+    static let currentSchemaVersion = 1
+
+    let schemaVersion: Int
+    let timestamp: String
+    /// Build identifier passed by CI through `BENCHMARK_REVISION`, so runs can be compared over time.
+    let revision: String?
+    let host: Host
+    let results: [BenchmarkResult]
+
+    init(results: [BenchmarkResult]) {
+        let processInfo = ProcessInfo.processInfo
+        schemaVersion = BenchmarkReport.currentSchemaVersion
+        timestamp = ISO8601DateFormatter().string(from: Date())
+        revision = processInfo.environment["BENCHMARK_REVISION"]
+        host = Host(operatingSystem: processInfo.operatingSystemVersionString,
+                    processorCount: processInfo.activeProcessorCount,
+                    physicalMemory: processInfo.physicalMemory)
+        self.results = results
+    }
+
+    func encoded() throws -> Data {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        return try encoder.encode(self)
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  Fixtures.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// Synthetic `rickandmortyapi.com` responses shipped with the benchmarks: written by hand in the
+/// API's response format from its public records, not recorded from it. The character pages
+/// hold the API's first 40 characters; `character-search-rick.json` is made up (five
+/// hand-picked Ricks on a single page, where the live search returns several pages); episode
+/// `characters` and location `residents` lists are trimmed. Replace them with a `ReplayRecorder`
+/// recording to benchmark against real payloads.
+///
+/// `manifest.json` maps every request (path + query) to the file holding its body,
+/// so the same fixtures can be replayed by `StubHTTPServer`, or in-process as a `ReplayBundle`
+/// (which is also what `ReplayRecorder` writes, e.g. from a device). Its `collections` list the
+/// fixtures every character, episode and location record can be looked up from by id.
+enum Fixtures {
+    struct Route: Codable {
+        let path: String
+        let query: String?
+        let fixture: String
+    }
+
+    struct Manifest: Codable {
+        let version: Int
+        let routes: [Route]
+        /// Resource name -> fixtures holding its records, used to answer any multi-id request.
+        let collections: [String: [String]]?
+    }
+
+    static let directory: URL = {
+        guard let url = Bundle.module.url(forResource: "Fixtures", withExtension: nil) else {
+            fatalError("Fixtures directory missing from the Benchmarks bundle")
+        }
+        return url
+    }()
+
+    static let manifest: Manifest = {
+        do {
+            return try JSONDecoder().decode(Manifest.self, from: data("manifest.json"))
+        } catch {
+            fatalError("Invalid fixtures manifest: \(error)")
+        }
+    }()
+
+    /// Characters in the API when the fixtures were written, their pages' `info.count`.
+    static let catalogueSize = 826
+
+    /// The fixture character pages, repeated with fresh ids `1...size`, as a stand-in for the
+    /// whole catalogue.
+    static func catalogue(size: Int = catalogueSize) throws -> [Character] {
+        let pages = try ["character-page-1.json", "character-page-2.json"].flatMap {
+            try JSONDecoder().decode(CharacterData.self, from: data($0)).results
+        }
+        return (0..<size).map { index -> Character in
+            var character = pages[index % pages.count]
+            character.id = index + 1
+            return character
+        }
+    }
+
+    static func data(_ name: String) -> Data {
+        do {
+            return try Data(contentsOf: directory.appendingPathComponent(name))
+        } catch {
+            fatalError("Missing fixture \(name): \(error)")
+        }
+    }
+}
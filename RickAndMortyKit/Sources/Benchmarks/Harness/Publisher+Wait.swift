@@ -0,0 +1,38 @@
+//
+//  Publisher+Wait.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+enum PublisherWaitError: Error {
+    case finishedWithoutValue
+}
+
+extension Publisher {
+    /// Blocks the calling thread until the publisher completes and returns its last value.
+    ///
+    /// Only safe when the publisher delivers on a queue other than the caller's.
+    func waitForValue() throws -> Output {
+        var result: Result<Output, Error> = .failure(PublisherWaitError.finishedWithoutValue)
+        var value: Output?
+        let semaphore = DispatchSemaphore(value: 0)
+
+        let cancellable = sink(receiveCompletion: { completion in
+            switch completion {
+            case .failure(let error): result = .failure(error)
+            case .finished: result = value.map { Result<Output, Error>.success($0) } ?? result
+            }
+            semaphore.signal()
+        }, receiveValue: { output in
+            value = output
+        })
+
+        semaphore.wait()
+        withExtendedLifetime(cancellable) {}
+        return try result.get()
+    }
+}
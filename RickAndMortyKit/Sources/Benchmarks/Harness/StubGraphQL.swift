@@ -0,0 +1,118 @@
+//
+//  StubGraphQL.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Answers the `characters(page:filter:)` queries `GraphQLCharacterService` sends, from the
+/// fixture character records, with only the selected fields, like the API's `/graphql`.
+///
+/// Only what the service uses is understood: the `page` and `filter` variables (filters match
+/// case-insensitive substrings), and `results { ... }` and `info { ... }` under `characters`.
+struct StubGraphQL {
+    struct Field {
+        let name: String
+        let fields: [Field]
+    }
+
+    static let pageSize = 20
+
+    /// Character records sorted by id.
+    let characters: [[String: Any]]
+
+    func response(to body: Data) -> Data? {
+        guard let request = (try? JSONSerialization.jsonObject(with: body)) as? [String: Any],
+              let document = request["query"] as? String,
+              let root = StubGraphQL.parse(document),
+              let characters = root.first(where: { $0.name == "characters" }) else { return nil }
+
+        let variables = request["variables"] as? [String: Any] ?? [:]
+        let filter = variables["filter"] as? [String: String] ?? [:]
+        let page = max(1, variables["page"] as? Int ?? 1)
+
+        let matches = characters.filter { record in
+            filter.allSatisfy { name, value in
+                (record[name] as? String)?.range(of: value, options: .caseInsensitive) != nil
+            }
+        }
+        let start = (page - 1) * StubGraphQL.pageSize
+        let payload: Any
+        if start < matches.count {
+            let records = matches[start..<min(matches.count, start + StubGraphQL.pageSize)]
+            var selected = [String: Any]()
+            for field in characters.fields {
+                switch field.name {
+                case "results":
+                    selected["results"] = records.map { StubGraphQL.project($0, field.fields) }
+                case "info":
+                    let info: [String: Any] = ["count": matches.count, "pages": (matches.count + StubGraphQL.pageSize - 1) / StubGraphQL.pageSize]
+                    selected["info"] = StubGraphQL.project(info, field.fields)
+                default:
+                    break
+                }
+            }
+            payload = selected
+        } else {
+            payload = NSNull()
+        }
+        return try? JSONSerialization.data(withJSONObject: ["data": ["characters": payload]])
+    }
+
+    private static func project(_ record: [String: Any], _ fields: [Field]) -> [String: Any] {
+        var projected = [String: Any]()
+        for field in fields {
+            let value = record[field.name]
+            if field.name == "id", let id = value as? Int {
+                projected["id"] = String(id)
+            } else if field.name == "episode", let urls = value as? [String] {
+                // REST lists episode urls, GraphQL episode objects.
+                projected["episode"] = urls.map { url in
+                    project(["id": url.split(separator: "/").last.map(String.init) ?? ""], field.fields)
+                }
+            } else if !field.fields.isEmpty, let object = value as? [String: Any] {
+                projected[field.name] = project(object, field.fields)
+            } else {
+                projected[field.name] = value ?? NSNull()
+            }
+        }
+        return projected
+    }
+
+    /// Top-level fields of the operation in `document`; arguments are skipped.
+    static func parse(_ document: String) -> [Field]? {
+        var depth = 0
+        var stripped = ""
+        for character in document {
+            if character == "(" { depth += 1 }
+            if depth == 0 {
+                stripped.append(character == "{" || character == "}" ? " \(character) " : String(character))
+            }
+            if character == ")" { depth -= 1 }
+        }
+
+        let tokens = stripped.split(whereSeparator: { $0 == " " || $0 == "\n" || $0 == "\t" || $0 == "," }).map(String.init)
+        guard var index = tokens.firstIndex(of: "{") else { return nil }
+        index += 1
+        return selectionSet(tokens, &index)
+    }
+
+    private static func selectionSet(_ tokens: [String], _ index: inout Int) -> [Field] {
+        var fields = [Field]()
+        while index < tokens.count {
+            let token = tokens[index]
+            index += 1
+            if token == "}" { break }
+
+            if index < tokens.count, tokens[index] == "{" {
+                index += 1
+                fields.append(Field(name: token, fields: selectionSet(tokens, &index)))
+            } else {
+                fields.append(Field(name: token, fields: []))
+            }
+        }
+        return fields
+    }
+}
@@ -0,0 +1,266 @@
+//
+//  StubHTTPServer.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(Glibc)
+import Glibc
+private let streamSocket = Int32(SOCK_STREAM.rawValue)
+#else
+import Darwin
+private let streamSocket = SOCK_STREAM
+#endif
+
+enum StubHTTPServerError: Error {
+    case socket(Int32)
+    case bind(Int32)
+    case listen(Int32)
+}
+
+/// Minimal HTTP/1.1 server bound to the loopback interface that replays the fixtures.
+///
+/// One request per connection (`Connection: close`), which is all `URLSession` needs for the
+/// benchmarks and keeps the server free of any parsing beyond the request line and
+/// `Content-Length`. `POST /graphql` is answered by `StubGraphQL` from the character records,
+/// and `/api/character?page=<n>` pages without a fixture are made up from the records
+/// with ids on that page, under the first page's `info`.
+final class StubHTTPServer {
+    private let routes: [Fixtures.Route]
+    private let queue = DispatchQueue(label: "benchmarks.stub-http-server", attributes: .concurrent)
+    private let lock = NSLock()
+    private var bodies = [String: Data]()
+    /// Resource name -> id -> record, for `/api/<resource>/<id>,<id>...` requests.
+    private var records = [String: [Int: Any]]()
+    private var graphQL = StubGraphQL(characters: [])
+    private var catalogueInfo: Any?
+    private var listeningSocket: Int32 = -1
+
+    private var _requestCount = 0
+    private var _bytesSent = 0
+
+    private(set) var port: UInt16 = 0
+
+    var baseURL: URL {
+        return URL(string: "http://127.0.0.1:\(port)")!
+    }
+
+    var requestCount: Int {
+        lock.lock(); defer { lock.unlock() }
+        return _requestCount
+    }
+
+    var bytesSent: Int {
+        lock.lock(); defer { lock.unlock() }
+        return _bytesSent
+    }
+
+    init(manifest: Fixtures.Manifest = Fixtures.manifest) {
+        self.routes = manifest.routes
+        for route in routes where bodies[route.fixture] == nil {
+            bodies[route.fixture] = Fixtures.data(route.fixture)
+        }
+        for (resource, fixtures) in manifest.collections ?? [:] {
+            for fixture in fixtures {
+                let json = try? JSONSerialization.jsonObject(with: Fixtures.data(fixture))
+                let list = (json as? [String: Any])?["results"] ?? json
+                for record in list as? [[String: Any]] ?? [] {
+                    guard let id = record["id"] as? Int else { continue }
+                    records[resource, default: [:]][id] = record
+                }
+            }
+        }
+        if let fixture = routes.first(where: { $0.path == "/api/character" && $0.query == "page=1" })?.fixture,
+           let page = bodies[fixture].flatMap({ try? JSONSerialization.jsonObject(with: $0) }) as? [String: Any] {
+            catalogueInfo = page["info"]
+        }
+        let characters = records["character"] ?? [:]
+        graphQL = StubGraphQL(characters: characters.keys.sorted().compactMap { characters[$0] as? [String: Any] })
+    }
+
+    deinit {
+        stop()
+    }
+
+    func start() throws {
+        signal(SIGPIPE, SIG_IGN)
+
+        let fd = socket(AF_INET, streamSocket, 0)
+        guard fd >= 0 else { throw StubHTTPServerError.socket(errno) }
+
+        var reuse: Int32 = 1
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, socklen_t(MemoryLayout<Int32>.size))
+
+        var address = sockaddr_in()
+        #if !os(Linux)
+        address.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+        #endif
+        address.sin_family = sa_family_t(AF_INET)
+        address.sin_port = in_port_t(0).bigEndian
+        address.sin_addr = in_addr(s_addr: UInt32(0x7F00_0001).bigEndian)
+
+        let length = socklen_t(MemoryLayout<sockaddr_in>.size)
+        let bound = withUnsafePointer(to: &address) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) { bind(fd, $0, length) }
+        }
+        guard bound == 0 else {
+            close(fd)
+            throw StubHTTPServerError.bind(errno)
+        }
+        guard listen(fd, 64) == 0 else {
+            close(fd)
+            throw StubHTTPServerError.listen(errno)
+        }
+
+        var boundLength = length
+        _ = withUnsafeMutablePointer(to: &address) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) { getsockname(fd, $0, &boundLength) }
+        }
+        port = UInt16(bigEndian: address.sin_port)
+        listeningSocket = fd
+
+        let thread = Thread { [weak self] in self?.acceptLoop(on: fd) }
+        thread.name = "StubHTTPServer.accept"
+        thread.start()
+    }
+
+    func stop() {
+        guard listeningSocket >= 0 else { return }
+        shutdown(listeningSocket, Int32(SHUT_RDWR))
+        close(listeningSocket)
+        listeningSocket = -1
+    }
+
+    /// What `POST /graphql` answers to `body`, without going through a socket.
+    func graphQLResponse(to body: Data) -> Data? {
+        return graphQL.response(to: body)
+    }
+
+    func resetCounters() {
+        lock.lock(); defer { lock.unlock() }
+        _requestCount = 0
+        _bytesSent = 0
+    }
+
+    private func acceptLoop(on fd: Int32) {
+        while true {
+            let client = accept(fd, nil, nil)
+            guard client >= 0 else { return }
+            queue.async { [weak self] in
+                self?.handle(client)
+                close(client)
+            }
+        }
+    }
+
+    private func handle(_ client: Int32) {
+        guard let (head, body) = readRequest(from: client),
+              let requestLine = head.components(separatedBy: "\r\n").first else { return }
+
+        let parts = requestLine.split(separator: " ")
+        guard parts.count >= 2 else { return }
+        let method = String(parts[0])
+
+        let target = String(parts[1])
+        let components = target.split(separator: "?", maxSplits: 1).map(String.init)
+        let path = components[0]
+        let query = components.count > 1 ? components[1] : nil
+
+        let response: Data
+        if method == "POST" {
+            if path == "/graphql", let answer = graphQL.response(to: body) {
+                response = makeResponse(status: "200 OK", body: answer)
+            } else {
+                response = makeResponse(status: "400 Bad Request", body: Data("{\"error\":\"Bad request\"}".utf8))
+            }
+        } else if let route = routes.first(where: { $0.path == path && $0.query == query }),
+           let body = bodies[route.fixture] {
+            response = makeResponse(status: "200 OK", body: body)
+        } else if path == "/api/character", let body = query.flatMap(pageBody(for:)) {
+            response = makeResponse(status: "200 OK", body: body)
+        } else if query == nil, let body = recordsBody(for: path) {
+            response = makeResponse(status: "200 OK", body: body)
+        } else {
+            response = makeResponse(status: "404 Not Found", body: Data("{\"error\":\"There is nothing here\"}".utf8))
+        }
+
+        response.withUnsafeBytes { buffer in
+            var offset = 0
+            while offset < buffer.count {
+                let sent = send(client, buffer.baseAddress! + offset, buffer.count - offset, 0)
+                guard sent > 0 else { return }
+                offset += sent
+            }
+        }
+
+        lock.lock()
+        _requestCount += 1
+        _bytesSent += response.count
+        lock.unlock()
+    }
+
+    /// `/api/episode/3` answers a bare object, `/api/episode/3,7` an array, like the real API:
+    /// an empty one when none of the ids exist.
+    private func recordsBody(for path: String) -> Data? {
+        let parts = path.split(separator: "/")
+        guard parts.count == 3, parts[0] == "api", let records = records[String(parts[1])] else { return nil }
+
+        let ids = parts[2].split(separator: ",").compactMap { Int($0) }
+        let found = ids.compactMap { records[$0] }
+        guard !found.isEmpty || ids.count > 1 else { return nil }
+
+        let object: Any = ids.count == 1 ? found[0] : found
+        return try? JSONSerialization.data(withJSONObject: object)
+    }
+
+    /// `page=<n>` of the character list, from the records with ids `20(n-1)+1...20n`.
+    private func pageBody(for query: String) -> Data? {
+        guard query.hasPrefix("page="), let page = Int(query.dropFirst("page=".count)), page > 0,
+              let characters = records["character"] else { return nil }
+
+        let ids = (page - 1) * 20 + 1...page * 20
+        let results = ids.compactMap { characters[$0] }
+        return try? JSONSerialization.data(withJSONObject: ["info": catalogueInfo ?? NSNull(), "results": results])
+    }
+
+    /// Head and body of the request; the body is read up to its `Content-Length`.
+    private func readRequest(from client: Int32) -> (head: String, body: Data)? {
+        var received = Data()
+        var buffer = [UInt8](repeating: 0, count: 4096)
+        let terminator = Data("\r\n\r\n".utf8)
+
+        func receive() -> Bool {
+            let count = recv(client, &buffer, buffer.count, 0)
+            guard count > 0 else { return false }
+            received.append(buffer, count: count)
+            return true
+        }
+
+        var headEnd = received.range(of: terminator)
+        while headEnd == nil {
+            guard receive() else { return nil }
+            headEnd = received.range(of: terminator)
+        }
+        guard let end = headEnd, let head = String(data: received[..<end.lowerBound], encoding: .utf8) else { return nil }
+
+        let contentLength = head.components(separatedBy: "\r\n")
+            .first { $0.lowercased().hasPrefix("content-length:") }
+            .flatMap { Int($0.dropFirst("content-length:".count).trimmingCharacters(in: .whitespaces)) } ?? 0
+        while received.count - end.upperBound < contentLength {
+            guard receive() else { return nil }
+        }
+        return (head, Data(received[end.upperBound...]))
+    }
+
+    private func makeResponse(status: String, body: Data) -> Data {
+        let head = "HTTP/1.1 \(status)\r\n"
+            + "Content-Type: application/json; charset=utf-8\r\n"
+            + "Content-Length: \(body.count)\r\n"
+            + "Connection: close\r\n\r\n"
+        var response = Data(head.utf8)
+        response.append(body)
+        return response
+    }
+}
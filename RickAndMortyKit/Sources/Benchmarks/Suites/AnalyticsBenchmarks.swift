@@ -0,0 +1,63 @@
+//
+//  AnalyticsBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// Cost of `Analytics.record` from one and from several threads, including the background
+/// drain into counters and histograms, and of the hitch monitor's per-cell instrumentation.
+enum AnalyticsBenchmarks {
+    static func make() -> [Benchmark] {
+        let events = 1_024
+        let producers = 4
+        let sink = LocalAnalyticsSink()
+        let analytics = Analytics(sink: sink, capacity: events * 2)
+
+        let counters: () -> [String: Double] = {
+            ["droppedEvents": Double(sink.summaries.reduce(0) { $0 + $1.droppedEvents })]
+        }
+
+        // One second of 60 Hz scrolling with 8 cells configured per frame and every tenth frame
+        // twice as long; interval and frame times are synthetic, only the bookkeeping is measured.
+        let frames = 60
+        let cellsPerFrame = 8
+        let frameDuration = 1.0 / 60
+        let monitor = HitchMonitor()
+        var hitchReport = HitchReport()
+
+        return [
+            Benchmark(suite: "analytics", name: "record + drain (1 producer)", items: events, counters: counters) {
+                for index in 0..<events {
+                    analytics.record(index % 2 == 0 ? .firstSeenCacheHit : .scrollDepth, value: Double(index))
+                }
+                analytics.flush(wait: true)
+            },
+            Benchmark(suite: "analytics", name: "record + drain (\(producers) producers)", items: events, counters: counters) {
+                DispatchQueue.concurrentPerform(iterations: producers) { producer in
+                    for index in 0..<(events / producers) {
+                        analytics.record(.searchLatency, value: Double(producer * index))
+                    }
+                }
+                analytics.flush(wait: true)
+            },
+            Benchmark(suite: "analytics", name: "hitch monitor, 1 s of scrolling", items: frames * cellsPerFrame,
+                      counters: { ["hitchTimeRatio": hitchReport.hitchTimeRatio] }) {
+                var time = 0.0
+                for frame in 0..<frames {
+                    let duration = frame % 10 == 9 ? frameDuration * 2 : frameDuration
+                    for cell in 0..<cellsPerFrame {
+                        let start = time + duration * Double(cell) / Double(cellsPerFrame)
+                        monitor.record(.cellConfigure, start: start, end: start + 0.0005)
+                    }
+                    monitor.recordFrame(start: time, end: time + duration, expected: frameDuration)
+                    time += duration
+                }
+                hitchReport = monitor.takeReport()
+            }
+        ]
+    }
+}
@@ -0,0 +1,79 @@
+//
+//  DecodeBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+enum DecodeBenchmarks {
+    /// Pages of the real catalogue (826 characters), for the full hydration benchmarks.
+    static let cataloguePages = 42
+
+    static func make() throws -> [Benchmark] {
+        let decoder = JSONDecoder()
+
+        let characterPage = Fixtures.data("character-page-1.json")
+        let characterCount = try decoder.decode(CharacterData.self, from: characterPage).results.count
+
+        let episodes = Fixtures.data("episode-1-20.json")
+        let episodeCount = try decoder.decode([Episode].self, from: episodes).count
+
+        let locations = Fixtures.data("location-1-20.json")
+        let locationCount = try decoder.decode([Location].self, from: locations).count
+
+        // Footprint growth while every page of the catalogue is held, eager against lazy records.
+        // Each page gets its own buffer, as responses do; lazy records keep theirs alive.
+        // Measured once, before any benchmark runs: in timed iterations the allocator reuses the
+        // pages the previous one freed and growth reads about 0. For the same reason the lazy
+        // catalogue stays alive while the eager one is measured. The peak is reported too, as it
+        // also counts the decoders' transient allocations.
+        func footprintGrowth(_ hydrate: () throws -> Any) rethrows -> (pages: Any, counters: [String: Double]) {
+            let before = MemoryFootprint.currentBytes ?? 0
+            let peakBefore = MemoryFootprint.peakBytes ?? 0
+            let pages = try hydrate()
+            let after = MemoryFootprint.currentBytes ?? 0
+            let peakAfter = MemoryFootprint.peakBytes ?? 0
+            return (pages, ["footprintGrowthBytes": after > before ? Double(after - before) : 0,
+                            "peakFootprintGrowthBytes": peakAfter > peakBefore ? Double(peakAfter - peakBefore) : 0])
+        }
+        let eagerCatalogue = {
+            try (0..<cataloguePages).map { _ in try decoder.decode(CharacterData.self, from: Data(Array(characterPage))) }
+        }
+        let lazyCatalogue = {
+            try (0..<cataloguePages).map { _ in try LazyCharacter.decodePage(Data(Array(characterPage))) }
+        }
+        let lazyGrowth = try footprintGrowth { try lazyCatalogue() }
+        let eagerFootprint = try footprintGrowth { try eagerCatalogue() }.counters
+        let lazyFootprint = lazyGrowth.counters
+        withExtendedLifetime(lazyGrowth.pages) {}
+
+        return [
+            Benchmark(suite: "decode", name: "CharacterData page", items: characterCount, bytes: characterPage.count) {
+                blackHole(try decoder.decode(CharacterData.self, from: characterPage))
+            },
+            Benchmark(suite: "decode", name: "LazyCharacter page", items: characterCount, bytes: characterPage.count) {
+                blackHole(try LazyCharacter.decodePage(characterPage))
+            },
+            Benchmark(suite: "decode", name: "LazyCharacter page, every record opened", items: characterCount, bytes: characterPage.count) {
+                blackHole(try LazyCharacter.decodePage(characterPage).map { try $0.character() })
+            },
+            Benchmark(suite: "decode", name: "CharacterData catalogue", items: characterCount * cataloguePages,
+                      counters: { eagerFootprint }) {
+                blackHole(try eagerCatalogue())
+            },
+            Benchmark(suite: "decode", name: "LazyCharacter catalogue", items: characterCount * cataloguePages,
+                      counters: { lazyFootprint }) {
+                blackHole(try lazyCatalogue())
+            },
+            Benchmark(suite: "decode", name: "Episode list", items: episodeCount, bytes: episodes.count) {
+                blackHole(try decoder.decode([Episode].self, from: episodes))
+            },
+            Benchmark(suite: "decode", name: "Location list", items: locationCount, bytes: locations.count) {
+                blackHole(try decoder.decode([Location].self, from: locations))
+            }
+        ]
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  ExperimentBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// What a page of `cellForRowAt` calls pays for experiment values: stored fields versus a
+/// name-keyed lookup per row.
+enum ExperimentBenchmarks {
+    static func make() -> [Benchmark] {
+        let rows = 1_000
+        let source = LocalExperimentValueSource(values: [
+            ExperimentConfig.Variables.showsFirstSeenIn.name: false
+        ])
+        let store = ExperimentConfigStore(source: source, scheduler: CoreSchedulers.queue(DispatchQueue(label: "benchmarks.experiments")))
+
+        return [
+            Benchmark(suite: "experiments", name: "config field per row", items: rows) {
+                var shown = 0
+                for _ in 0..<rows where store.current.showsFirstSeenIn {
+                    shown += 1
+                }
+                blackHole(shown)
+            },
+            Benchmark(suite: "experiments", name: "value source lookup per row", items: rows) {
+                var shown = 0
+                for _ in 0..<rows where source.value(of: ExperimentConfig.Variables.showsFirstSeenIn) {
+                    shown += 1
+                }
+                blackHole(shown)
+            }
+        ]
+    }
+}
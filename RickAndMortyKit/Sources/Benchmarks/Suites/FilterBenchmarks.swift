@@ -0,0 +1,64 @@
+//
+//  FilterBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// Filter chips over a synthetic 100k-row list: scanning the characters with a predicate
+/// against intersecting the `CharacterFacetIndex` bitmaps, for the filtered rows and for the
+/// live counts shown next to every value.
+enum FilterBenchmarks {
+    static let rowCount = 100_000
+
+    static func make() throws -> [Benchmark] {
+        let characters = try Fixtures.catalogue(size: rowCount)
+        let index = CharacterFacetIndex(characters: characters)
+        let filter = CharacterFilter([.status: ["Alive"], .species: ["Human", "Alien"]])
+
+        let facetValues = index.facetCounts(for: .none).values.joined().count
+        let counters: () -> [String: Double] = {
+            ["facetValues": Double(facetValues), "matchingRows": Double(index.count(matching: filter))]
+        }
+
+        return [
+            Benchmark(suite: "filter", name: "index build", items: rowCount) {
+                blackHole(CharacterFacetIndex(characters: characters))
+            },
+            Benchmark(suite: "filter", name: "predicate scan, matching rows", items: rowCount, counters: counters) {
+                blackHole(characters.filter(filter.matches))
+            },
+            Benchmark(suite: "filter", name: "bitmap intersection, matching rows", items: rowCount) {
+                blackHole(index.characters(matching: filter))
+            },
+            Benchmark(suite: "filter", name: "bitmap intersection, match count", items: rowCount) {
+                blackHole(index.count(matching: filter))
+            },
+            Benchmark(suite: "filter", name: "predicate scan, facet counts", items: rowCount) {
+                blackHole(scanFacetCounts(characters, filter: filter))
+            },
+            Benchmark(suite: "filter", name: "bitmap popcount, facet counts", items: rowCount) {
+                blackHole(index.facetCounts(for: filter))
+            }
+        ]
+    }
+
+    /// What the counts cost without an index: per facet, one pass grouping the rows that match
+    /// the other facets' selections.
+    private static func scanFacetCounts(_ characters: [Character], filter: CharacterFilter) -> [CharacterFacet: [String: Int]] {
+        var counts = [CharacterFacet: [String: Int]]()
+        for facet in CharacterFacet.allCases {
+            var others = filter
+            others.selections[facet] = nil
+            var values = [String: Int]()
+            for character in characters where others.matches(character) {
+                values[facet.value(of: character), default: 0] += 1
+            }
+            counts[facet] = values
+        }
+        return counts
+    }
+}
@@ -0,0 +1,45 @@
+//
+//  GraphBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+enum GraphBenchmarks {
+    static func make() throws -> [Benchmark] {
+        let decoder = JSONDecoder()
+        let characters = try ["character-page-1.json", "character-page-2.json"].flatMap {
+            try decoder.decode(CharacterData.self, from: Fixtures.data($0)).results
+        }
+        let episodes = try decoder.decode([Episode].self, from: Fixtures.data("episode-1-20.json"))
+        let locations = try decoder.decode([Location].self, from: Fixtures.data("location-1-20.json"))
+
+        let graph = RelationshipGraph()
+        graph.ingest(characters)
+        graph.ingest(episodes)
+        graph.ingest(locations)
+
+        return [
+            Benchmark(suite: "graph", name: "ingest", items: characters.count + episodes.count + locations.count) {
+                let graph = RelationshipGraph()
+                graph.ingest(characters)
+                graph.ingest(episodes)
+                graph.ingest(locations)
+                blackHole(graph)
+            },
+            Benchmark(suite: "graph", name: "first episode per character", items: characters.count) {
+                for character in characters {
+                    blackHole(graph.firstEpisode(ofCharacter: character.id))
+                }
+            },
+            Benchmark(suite: "graph", name: "characters in episode", items: episodes.count) {
+                for episode in episodes {
+                    blackHole(graph.characters(inEpisode: episode.id))
+                }
+            }
+        ]
+    }
+}
@@ -0,0 +1,174 @@
+//
+//  PipelineBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+import RickAndMortyCore
+
+/// `CharacterRepository` round trips against `StubHTTPServer`.
+///
+/// The view model benchmarks run with the tuning knobs of `tuning` (see `--tuning`), so
+/// variants can be compared before they are served to devices.
+///
+/// The refresh stress benchmark fails the run when fetches overlap or outlive their load.
+enum PipelineBenchmarks {
+    static let refreshBurst = 50
+
+    struct SubscriptionLeak: Error, CustomStringConvertible {
+        let live: Int
+        let peak: Int
+
+        var description: String {
+            return "\(live) fetch subscriptions left after a refresh burst, \(peak) alive at once"
+        }
+    }
+
+    static func make(server: StubHTTPServer, tuning: ExperimentConfig = .defaults) -> [Benchmark] {
+        let delivery = DispatchQueue(label: "benchmarks.pipeline.delivery")
+        let service = CharacterApiService(session: URLSession(configuration: .ephemeral),
+                                          baseURL: server.baseURL,
+                                          scheduler: CoreSchedulers.queue(delivery),
+                                          tracer: nil)
+        let repository = CharacterRepository(service: service)
+        let episodeService = ResourceApiService<Episode>(session: URLSession(configuration: .ephemeral),
+                                                         baseURL: server.baseURL,
+                                                         scheduler: CoreSchedulers.queue(delivery))
+        let warmEpisodes = EpisodeRepository(resources: ResourceRepository(service: episodeService))
+        let episodeIDs = Array(1...20)
+        let page = (try? JSONDecoder().decode(CharacterData.self, from: Fixtures.data("character-page-1.json")))?.results ?? []
+        var maximumEpisodeRequestsPerPage = 0
+
+        let counters: () -> [String: Double] = {
+            let counters = ["requests": Double(server.requestCount), "bytes": Double(server.bytesSent)]
+            server.resetCounters()
+            return counters
+        }
+
+        let analyticsSink = LocalAnalyticsSink()
+        let analytics = Analytics(sink: analyticsSink)
+        let tunedViewModel: () -> CharacterViewModel = {
+            let viewModel = CharacterViewModel(repository: CharacterRepository(service: service),
+                                               analytics: analytics,
+                                               scheduler: CoreSchedulers.queue(delivery))
+            viewModel.apply(tuning)
+            return viewModel
+        }
+        let tuningCounters: () -> [String: Double] = {
+            analytics.flush(wait: true)
+            var histograms = [AnalyticsMetric: AnalyticsHistogram]()
+            for summary in analyticsSink.summaries {
+                for (metric, histogram) in summary.histograms {
+                    histograms[metric] = histogram
+                }
+            }
+            var counters = [
+                "pageSize": Double(tuning.pageSize),
+                "searchDebounceMilliseconds": Double(tuning.searchDebounceMilliseconds),
+                "memoryFootprintMegabytes": Double(MemoryFootprint.currentBytes ?? 0) / (1024 * 1024)
+            ]
+            counters["pageLoadLatencyP50Milliseconds"] = histograms[.pageLoadLatency]?.quantile(0.5)
+            counters["searchLatencyP50Milliseconds"] = histograms[.searchLatency]?.quantile(0.5)
+            return counters
+        }
+        
+        var peakFetches = 0
+        let lifecycleCounters: () -> [String: Double] = {
+            ["peakFetchSubscriptions": Double(peakFetches)]
+        }
+
+        return [
+            Benchmark(suite: "pipeline", name: "view model first load (tuned)", items: tuning.pageSize, counters: tuningCounters) {
+                let viewModel = tunedViewModel()
+                let semaphore = DispatchSemaphore(value: 0)
+                var subscription: AnyCancellable?
+                delivery.sync {
+                    subscription = viewModel.state.dropFirst().sink { state in
+                        if case .loading = state { return }
+                        semaphore.signal()
+                    }
+                    viewModel.fetchCharacters()
+                }
+                semaphore.wait()
+                delivery.sync { subscription?.cancel() }
+                blackHole(viewModel.characters.value)
+            },
+            Benchmark(suite: "pipeline", name: "view model search (tuned debounce)", counters: tuningCounters) {
+                let viewModel = tunedViewModel()
+                let semaphore = DispatchSemaphore(value: 0)
+                var subscription: AnyCancellable?
+                delivery.sync {
+                    subscription = viewModel.characters.dropFirst().sink { _ in semaphore.signal() }
+                    viewModel.searchText.send("rick")
+                }
+                semaphore.wait()
+                delivery.sync { subscription?.cancel() }
+                blackHole(viewModel.characters.value)
+            },
+            Benchmark(suite: "pipeline", name: "view model refresh burst", items: refreshBurst, counters: lifecycleCounters) {
+                let viewModel = tunedViewModel()
+                let semaphore = DispatchSemaphore(value: 0)
+                var subscription: AnyCancellable?
+                delivery.sync {
+                    // Each refresh supersedes the previous one; only the last one finishes.
+                    subscription = viewModel.state.dropFirst().sink { state in
+                        if case .loading = state { return }
+                        semaphore.signal()
+                    }
+                    for _ in 0..<refreshBurst {
+                        viewModel.fetchCharacters()
+                    }
+                }
+                semaphore.wait()
+                let (live, peak, active) = delivery.sync { () -> (Int, Int, Int) in
+                    subscription?.cancel()
+                    return (viewModel.subscriptions.count("fetch"), viewModel.subscriptions.peak("fetch"), viewModel.activeRequestCount)
+                }
+                peakFetches = max(peakFetches, peak)
+                guard live == 0, peak == 1, active == 0 else {
+                    throw SubscriptionLeak(live: live + active, peak: peak)
+                }
+            },
+            Benchmark(suite: "pipeline", name: "repository fetchCharacters", items: 20, counters: counters) {
+                blackHole(try repository.fetchCharacters().waitForValue())
+            },
+            Benchmark(suite: "pipeline", name: "repository searchCharacter", counters: counters) {
+                blackHole(try repository.searchCharacter(with: "name=rick").waitForValue())
+            },
+            Benchmark(suite: "pipeline", name: "episode repository batch (cold cache)", items: episodeIDs.count, counters: counters) {
+                let episodes = EpisodeRepository(resources: ResourceRepository(service: episodeService))
+                blackHole(try episodes.fetchEpisodes(ids: episodeIDs).waitForValue())
+            },
+            Benchmark(suite: "pipeline", name: "episode repository batch (warm cache)", items: episodeIDs.count, counters: counters) {
+                blackHole(try warmEpisodes.fetchEpisodes(ids: episodeIDs).waitForValue())
+            },
+            Benchmark(suite: "pipeline", name: "first seen resolver page", items: page.count, counters: {
+                ["maximumEpisodeRequestsPerPage": Double(maximumEpisodeRequestsPerPage)]
+            }) {
+                let resolver = FirstSeenResolver(episodes: EpisodeRepository(resources: ResourceRepository(service: episodeService)),
+                                                 scheduler: CoreSchedulers.queue(delivery))
+                let semaphore = DispatchSemaphore(value: 0)
+                var resolved = Set<Int>()
+                var subscription: AnyCancellable?
+                delivery.sync {
+                    subscription = resolver.resolved.sink { ids in
+                        resolved.formUnion(ids)
+                        if resolved.count == page.count { semaphore.signal() }
+                    }
+                    // A loaded page, then its visible and prefetched rows, as the list does.
+                    resolver.resolve(page)
+                    resolver.resolve(Array(page.prefix(8)))
+                    resolver.resolve(Array(page.suffix(12)))
+                }
+                semaphore.wait()
+                withExtendedLifetime(subscription) {}
+                maximumEpisodeRequestsPerPage = max(maximumEpisodeRequestsPerPage, resolver.requestCount)
+            }
+        ]
+    }
+}
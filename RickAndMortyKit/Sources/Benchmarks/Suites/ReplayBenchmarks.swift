@@ -0,0 +1,61 @@
+//
+//  ReplayBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+import RickAndMortyCore
+
+/// `CharacterApiService` against the checked-in fixtures replayed in-process by `NetworkHarness`,
+/// with no socket involved, under each network preset. The same bundle can be replayed in the
+/// app with `RM_NETWORK_REPLAY`, so device and CI numbers come from identical responses.
+enum ReplayBenchmarks {
+    static func make() throws -> [Benchmark] {
+        let delivery = DispatchQueue(label: "benchmarks.replay.delivery")
+        let harness = NetworkHarness(mode: .replay(try ReplayBundle(directory: Fixtures.directory)))
+        let service = CharacterApiService(session: harness.makeSession(),
+                                          scheduler: CoreSchedulers.queue(delivery),
+                                          tracer: nil)
+        let page = Fixtures.data("character-page-1.json")
+
+        let counters: () -> [String: Double] = {
+            let statistics = harness.statistics
+            harness.resetStatistics()
+            return ["requests": Double(statistics.requests),
+                    "injectedFailures": Double(statistics.injectedFailures),
+                    "unmatched": Double(statistics.unmatched),
+                    "bytes": Double(statistics.bytes)]
+        }
+
+        let presets: [(name: String, conditions: NetworkConditions)] = [
+            ("ideal", .ideal), ("wifi", .wifi), ("lte", .lte), ("3g", .slow3G)
+        ]
+        return presets.map { (name, conditions) in
+            Benchmark(suite: "replay", name: "fetchCharacters (\(name))", items: 20, bytes: page.count, counters: counters) {
+                harness.conditions = conditions
+                blackHole(try service.fetchCharacters().waitForValue())
+            }
+        } + [
+            // Injected failures are part of the run: they are counted, and retried with a new request
+            // (a `Future` would replay its failure).
+            Benchmark(suite: "replay", name: "fetchCharacters (lossy, retried)", items: 20, bytes: page.count, counters: counters) {
+                harness.conditions = .lossy
+                blackHole(try Deferred { service.fetchCharacters() }.retry(3).waitForValue())
+            },
+            // Requests in flight together share nothing but the seeded random draws: each gets its own
+            // latency and bandwidth, like separate connections.
+            Benchmark(suite: "replay", name: "two pages and a search in parallel (3g)", items: 60, counters: counters) {
+                harness.conditions = .slow3G
+                let requests = Publishers.MergeMany(service.fetchCharacters(page: 1),
+                                                    service.fetchCharacters(page: 2),
+                                                    service.searchCharacter(with: "name=rick"))
+                blackHole(try requests.collect().waitForValue())
+            }
+        ]
+    }
+}
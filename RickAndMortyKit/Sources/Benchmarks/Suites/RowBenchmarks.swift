@@ -0,0 +1,55 @@
+//
+//  RowBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// Per-cell configure cost: formatting each character on every display, as `cellForRowAt` used
+/// to, against reading rows precomputed by `RowModelBuilder`.
+enum RowBenchmarks {
+    /// Stand-in for the cell's labels and image view.
+    private final class Cell {
+        var name: String?
+        var status: String?
+        var location: String?
+        var imageURL: URL?
+    }
+
+    static func make() throws -> [Benchmark] {
+        let characters = try JSONDecoder().decode(CharacterData.self, from: Fixtures.data("character-page-1.json")).results
+        let builder = RowModelBuilder { $0 }
+        let rows = builder.rows(for: characters)
+        let cell = Cell()
+
+        return [
+            Benchmark(suite: "rows", name: "configure formatting per display", items: characters.count) {
+                for character in characters {
+                    cell.name = character.name
+                    cell.status = "\(character.status) - \(character.gender)"
+                    cell.location = character.location.name
+                    cell.imageURL = URL(string: character.image)
+                }
+                blackHole(cell)
+            },
+            Benchmark(suite: "rows", name: "configure precomputed row", items: rows.count) {
+                for row in rows {
+                    cell.name = row.name
+                    cell.status = row.statusText
+                    cell.location = row.locationName
+                    cell.imageURL = row.imageURL
+                }
+                blackHole(cell)
+            },
+            Benchmark(suite: "rows", name: "build rows (cold cache)", items: characters.count) {
+                blackHole(RowModelBuilder { $0 }.rows(for: characters))
+            },
+            Benchmark(suite: "rows", name: "build rows (page refresh)", items: characters.count) {
+                blackHole(builder.rows(for: characters))
+            }
+        ]
+    }
+}
@@ -0,0 +1,92 @@
+//
+//  SearchBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// Fuzzy name search over a catalogue-sized list: building the trigram index, and single
+/// keystrokes, so the reported p99 is per keystroke.
+///
+/// The first keystroke after launch is measured on a freshly opened `CharacterStore`, with the
+/// index persisted next to its snapshot and without it (rebuilt from the snapshot's names).
+///
+/// The fixture pages only hold 40 distinct names, so names are recombined from their first
+/// and last words to get one distinct name per character.
+enum SearchBenchmarks {
+    static let typedQueries = ["mortimer smth", "rick sanchex", "jery", "beth smiht", "summer"]
+
+    static func make() throws -> [Benchmark] {
+        let entries = try names(count: Fixtures.catalogueSize)
+        let index = FuzzyNameIndex(entries: entries)
+
+        // Every prefix of every query, typed one keystroke per iteration.
+        let keystrokes = typedQueries.flatMap { query in (1...query.count).map { String(query.prefix($0)) } }
+        var next = 0
+
+        let archive = index.encoded()
+        let (persistedStore, bareStore) = try storeFiles(entries: entries)
+
+        let counters: () -> [String: Double] = {
+            ["matches": Double(typedQueries.map { index.search($0).count }.reduce(0, +))]
+        }
+
+        return [
+            Benchmark(suite: "search", name: "index build", items: entries.count) {
+                blackHole(FuzzyNameIndex(entries: entries))
+            },
+            Benchmark(suite: "search", name: "query with typos", items: typedQueries.count, counters: counters) {
+                blackHole(typedQueries.map { index.search($0) })
+            },
+            Benchmark(suite: "search", name: "keystroke", items: 1) {
+                blackHole(index.search(keystrokes[next]))
+                next = (next + 1) % keystrokes.count
+            },
+            Benchmark(suite: "search", name: "index load", items: entries.count, bytes: archive.count) {
+                blackHole(try FuzzyNameIndex(data: archive))
+            },
+            Benchmark(suite: "search", name: "first keystroke after launch, persisted index", items: 1) {
+                blackHole(CharacterStore(fileURL: persistedStore).fuzzySearch(name: typedQueries[0]))
+            },
+            Benchmark(suite: "search", name: "first keystroke after launch, rebuilt index", items: 1) {
+                blackHole(CharacterStore(fileURL: bareStore).fuzzySearch(name: typedQueries[0]))
+            }
+        ]
+    }
+
+    /// Two copies of a store holding the catalogue under `entries`' names: as the app leaves it,
+    /// and without the persisted search index.
+    private static func storeFiles(entries: [(id: Int, name: String)]) throws -> (persisted: URL, bare: URL) {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("RickAndMortyBenchmarks-\(UUID().uuidString)", isDirectory: true)
+        let persisted = directory.appendingPathComponent("persisted/characters.json")
+        let bare = directory.appendingPathComponent("bare/characters.json")
+
+        var characters = try Fixtures.catalogue(size: entries.count)
+        for (index, entry) in entries.enumerated() {
+            characters[index].name = entry.name
+        }
+        let store = CharacterStore(fileURL: persisted)
+        store.save(characters, page: 1)
+        store.flush()
+
+        try FileManager.default.createDirectory(at: bare.deletingLastPathComponent(), withIntermediateDirectories: true)
+        for file in ["characters.json", "characters.snapshot"] {
+            try FileManager.default.copyItem(at: persisted.deletingLastPathComponent().appendingPathComponent(file),
+                                             to: bare.deletingLastPathComponent().appendingPathComponent(file))
+        }
+        return (persisted, bare)
+    }
+
+    static func names(count: Int) throws -> [(id: Int, name: String)] {
+        let words = try Fixtures.catalogue(size: 40).map { $0.name.split(separator: " ") }
+        let firsts = Array(Set(words.compactMap(\.first))).sorted()
+        let lasts = Array(Set(words.compactMap { $0.count > 1 ? $0.last : nil })).sorted()
+        return (0..<count).map { index in
+            (id: index + 1, name: "\(firsts[index % firsts.count]) \(lasts[(index / firsts.count) % lasts.count])")
+        }
+    }
+}
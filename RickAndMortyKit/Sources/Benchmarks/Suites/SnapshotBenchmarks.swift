@@ -0,0 +1,69 @@
+//
+//  SnapshotBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// Launch-time cost of reading the cached catalogue back: decoding it from JSON against
+/// memory-mapping a `CharacterSnapshot`, at the size of the real catalogue.
+///
+/// Files are read back right after being written, so they come from the page cache rather
+/// than the disk; the difference measured is the parse step.
+enum SnapshotBenchmarks {
+    static let catalogueSize = Fixtures.catalogueSize
+    static let firstPage = 0..<20
+
+    static func make() throws -> [Benchmark] {
+        let decoder = JSONDecoder()
+        let catalogue = try Fixtures.catalogue()
+
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("RickAndMortyBenchmarks-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+
+        let jsonURL = directory.appendingPathComponent("catalogue.json")
+        let json = try JSONEncoder().encode(catalogue)
+        try json.write(to: jsonURL)
+
+        let snapshotURL = directory.appendingPathComponent("catalogue.snapshot")
+        let snapshot = CharacterSnapshot.encode(catalogue)
+        try snapshot.write(to: snapshotURL)
+
+        // A store as the app leaves it: every page saved, then flushed to disk.
+        let storeURL = directory.appendingPathComponent("characters.json")
+        let store = CharacterStore(fileURL: storeURL)
+        for page in 0..<(catalogueSize + 19) / 20 {
+            store.save(Array(catalogue[page * 20..<min(catalogueSize, page * 20 + 20)]), page: page + 1)
+        }
+        store.flush()
+
+        return [
+            Benchmark(suite: "snapshot", name: "JSON cache decode, first page", items: catalogueSize, bytes: json.count) {
+                let characters = try decoder.decode([Character].self, from: Data(contentsOf: jsonURL))
+                blackHole(characters[firstPage].map(\.name))
+            },
+            Benchmark(suite: "snapshot", name: "mmap snapshot open, first page", items: catalogueSize, bytes: snapshot.count) {
+                let snapshot = try CharacterSnapshot(contentsOf: snapshotURL)
+                blackHole(firstPage.map(snapshot.character(at:)))
+            },
+            Benchmark(suite: "snapshot", name: "mmap snapshot open, every character", items: catalogueSize, bytes: snapshot.count) {
+                let snapshot = try CharacterSnapshot(contentsOf: snapshotURL)
+                blackHole((0..<snapshot.count).map(snapshot.character(at:)))
+            },
+            Benchmark(suite: "snapshot", name: "CharacterStore cold start, page 1", items: firstPage.count) {
+                blackHole(CharacterStore(fileURL: storeURL).characters(page: 1))
+            },
+            Benchmark(suite: "snapshot", name: "encode", items: catalogueSize, bytes: snapshot.count) {
+                blackHole(CharacterSnapshot.encode(catalogue))
+            },
+            // A refreshed first page written over the snapshot, as `CharacterStore` does on flush.
+            Benchmark(suite: "snapshot", name: "encode over snapshot, first page changed", items: firstPage.count, bytes: snapshot.count) {
+                blackHole(CharacterSnapshot.encode(Array(catalogue[firstPage]), over: try CharacterSnapshot(data: snapshot)))
+            }
+        ]
+    }
+}
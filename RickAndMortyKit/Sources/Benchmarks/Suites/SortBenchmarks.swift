@@ -0,0 +1,54 @@
+//
+//  SortBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import RickAndMortyCore
+
+/// Sorting and grouping the list as the catalogue loads page by page, and switching layouts:
+/// re-sorting the whole array each time against `CharacterSortIndex`'s merged permutations.
+enum SortBenchmarks {
+    static let pageSize = 20
+
+    static func make() throws -> [Benchmark] {
+        let catalogue = try Fixtures.catalogue()
+        let pageCount = (catalogue.count + pageSize - 1) / pageSize
+        let loaded = (1...pageCount).map { Array(catalogue.prefix($0 * pageSize)) }
+
+        let index = CharacterSortIndex(characters: catalogue)
+        let byName = CharacterListLayout(order: .name, grouping: .none)
+        let byEpisodes = CharacterListLayout(order: .episodeCount, grouping: .species)
+        let nameList = CharacterSectionedList(characters: catalogue, sections: index.sections(for: byName))
+        let episodesList = CharacterSectionedList(characters: catalogue, sections: index.sections(for: byEpisodes))
+
+        return [
+            Benchmark(suite: "sort", name: "page arrivals, full re-sort", items: catalogue.count) {
+                for characters in loaded {
+                    blackHole(characters.sorted { ($0.name.lowercased(), $0.id) < ($1.name.lowercased(), $1.id) })
+                }
+            },
+            Benchmark(suite: "sort", name: "page arrivals, incremental merge (every order)", items: catalogue.count) {
+                let index = CharacterSortIndex()
+                for characters in loaded {
+                    index.update(with: characters)
+                }
+                blackHole(index.rows(sortedBy: .name))
+            },
+            Benchmark(suite: "sort", name: "layout switch, re-sort and group", items: catalogue.count) {
+                let sorted = catalogue.sorted {
+                    (-$0.episode.count, $0.name.lowercased(), $0.id) < (-$1.episode.count, $1.name.lowercased(), $1.id)
+                }
+                blackHole(Dictionary(grouping: sorted, by: \.species))
+            },
+            Benchmark(suite: "sort", name: "layout switch, permutation", items: catalogue.count) {
+                blackHole(index.sections(for: byEpisodes))
+            },
+            Benchmark(suite: "sort", name: "sectioned diff, layout switch", items: catalogue.count) {
+                blackHole(episodesList.difference(from: nameList))
+            }
+        ]
+    }
+}
@@ -0,0 +1,110 @@
+//
+//  StartupBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+import RickAndMortyCore
+
+/// Collects the trace of every simulated launch, so `main.swift` can check their median
+/// against the startup budget.
+final class StartupTraceRecorder {
+    private(set) var traces = [StartupTrace]()
+
+    var median: StartupTrace? {
+        return traces.isEmpty ? nil : StartupTrace.median(of: traces)
+    }
+
+    func record(_ trace: StartupTrace) {
+        traces.append(trace)
+    }
+}
+
+/// Replays the app's launch path against `StubHTTPServer`: the launch orchestrator's first
+/// fetch, the list binding to the view model, and the first row being configured.
+/// Avatars are not served by the stub, so `firstAvatarRendered` is only traced by the app.
+///
+/// The default launch defers the experiment SDK, as the app does; its median is what the startup
+/// budget checks. The other variants start `LocalExperimentPlatform` in `didFinishLaunching`,
+/// blocking for metadata like `ApptimizeDelayUntilTestsAreAvailableOption` does, with slow,
+/// absent or no (offline) metadata.
+enum StartupBenchmarks {
+    /// How long a blocking start may wait for metadata.
+    static let metadataTimeout: TimeInterval = 0.1
+
+    static func make(server: StubHTTPServer, recorder: StartupTraceRecorder) -> [Benchmark] {
+        let revision = ProcessInfo.processInfo.environment["BENCHMARK_REVISION"]
+
+        let counters: () -> [String: Double] = {
+            var counters = [String: Double]()
+            for (phase, milliseconds) in recorder.median?.phases ?? [:] {
+                counters["\(phase)Milliseconds"] = milliseconds
+            }
+            return counters
+        }
+
+        func blockingStart(latency: TimeInterval?, offline: Bool = false) -> () -> Void {
+            return {
+                let platform = LocalExperimentPlatform(metadataLatency: latency)
+                platform.setOffline(offline)
+                platform.start(applicationKey: "benchmarks", waitingForMetadataUpTo: metadataTimeout)
+            }
+        }
+
+        return [
+            Benchmark(suite: "startup", name: "launch to first row", items: 1, counters: counters) {
+                recorder.record(launch(server: server, revision: revision))
+            },
+            Benchmark(suite: "startup", name: "launch to first row (blocking experiments, metadata in 20 ms)") {
+                blackHole(launch(server: server, revision: revision, startExperiments: blockingStart(latency: 0.02)))
+            },
+            Benchmark(suite: "startup", name: "launch to first row (blocking experiments, metadata absent)") {
+                blackHole(launch(server: server, revision: revision, startExperiments: blockingStart(latency: nil)))
+            },
+            Benchmark(suite: "startup", name: "launch to first row (blocking experiments, offline)") {
+                blackHole(launch(server: server, revision: revision, startExperiments: blockingStart(latency: nil, offline: true)))
+            }
+        ]
+    }
+
+    private static func launch(server: StubHTTPServer, revision: String?, startExperiments: () -> Void = {}) -> StartupTrace {
+        let tracer = StartupTracer()
+        let delivery = DispatchQueue(label: "benchmarks.startup.delivery")
+        let service = CharacterApiService(session: URLSession(configuration: .ephemeral),
+                                          baseURL: server.baseURL,
+                                          scheduler: CoreSchedulers.queue(delivery),
+                                          tracer: tracer)
+        let viewModel = CharacterViewModel(repository: CharacterRepository(service: service),
+                                           scheduler: CoreSchedulers.queue(delivery))
+        let semaphore = DispatchSemaphore(value: 0)
+        var subscription: AnyCancellable?
+
+        delivery.sync {
+            tracer.mark(.didFinishLaunching)
+            viewModel.fetchCharacters()
+            // Where LaunchOrchestrator starts the SDK when it is not deferred.
+            startExperiments()
+
+            tracer.mark(.charactersViewLoaded)
+            subscription = viewModel.characters
+                .first { !$0.isEmpty }
+                .sink { characters in
+                    let character = characters[0]
+                    blackHole((character.name, "\(character.status) - \(character.gender)", URL(string: character.image)))
+                    tracer.mark(.firstRowRendered)
+                    semaphore.signal()
+                }
+        }
+        semaphore.wait()
+        // Let the fetch's completion drain before the view model goes away.
+        delivery.sync { subscription?.cancel() }
+        withExtendedLifetime(viewModel) {}
+
+        return tracer.trace(revision: revision)
+    }
+}
@@ -0,0 +1,62 @@
+//
+//  SyncBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+import RickAndMortyCore
+
+/// Bytes and requests needed to refresh a fully cached catalogue: every page again, against a
+/// `CatalogueDeltaSync` refresh with nothing new upstream.
+enum SyncBenchmarks {
+    static func make(server: StubHTTPServer) throws -> [Benchmark] {
+        let delivery = DispatchQueue(label: "benchmarks.sync.delivery")
+        let session = URLSession(configuration: .ephemeral)
+        let meter = TransferMeter()
+        let service = CharacterApiService(session: session,
+                                          baseURL: server.baseURL,
+                                          scheduler: CoreSchedulers.queue(delivery),
+                                          tracer: nil,
+                                          meter: meter)
+        let characters = ResourceApiService<Character>(session: session,
+                                                       baseURL: server.baseURL,
+                                                       scheduler: CoreSchedulers.queue(delivery),
+                                                       meter: meter)
+
+        let catalogue = try Fixtures.catalogue()
+        let pages = (catalogue.count + CatalogueDeltaSync.pageSize - 1) / CatalogueDeltaSync.pageSize
+        let store = CharacterStore(fileURL: nil)
+        store.save(catalogue: catalogue, state: CatalogueSyncState(count: catalogue.count, pages: pages, revalidationCursor: 0))
+        let deltaSync = CatalogueDeltaSync(service: service, characters: characters, store: store, meter: meter)
+
+        var fullTransfer: TransferMeter.Reading?
+        var deltaTransfer: TransferMeter.Reading?
+        func counters(_ transfer: @escaping () -> TransferMeter.Reading?) -> () -> [String: Double] {
+            return {
+                ["bytesPerRefresh": Double(transfer()?.bytes ?? 0), "requestsPerRefresh": Double(transfer()?.requests ?? 0)]
+            }
+        }
+
+        return [
+            Benchmark(suite: "sync", name: "full refresh (every page)", items: catalogue.count, counters: counters { fullTransfer }) {
+                let start = meter.reading
+                let refreshed = try Publishers.Sequence<[Int], Error>(sequence: Array(1...pages))
+                    .flatMap(maxPublishers: .max(2)) { page in service.fetchCharacters(page: page) }
+                    .collect()
+                    .waitForValue()
+                fullTransfer = meter.reading.since(start)
+                blackHole(refreshed)
+            },
+            Benchmark(suite: "sync", name: "delta refresh (nothing new)", items: catalogue.count, counters: counters { deltaTransfer }) {
+                let refresh = try deltaSync.refresh().waitForValue()
+                deltaTransfer = refresh.transfer
+                blackHole(refresh)
+            }
+        ]
+    }
+}
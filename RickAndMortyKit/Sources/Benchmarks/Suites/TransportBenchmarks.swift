@@ -0,0 +1,69 @@
+//
+//  TransportBenchmarks.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+import RickAndMortyCore
+
+/// Payload size and decode time of a character page over REST against `GraphQLCharacterService`
+/// with the list projection (and with the episode ids the "First seen in" row needs).
+enum TransportBenchmarks {
+    static func make(server: StubHTTPServer) throws -> [Benchmark] {
+        let delivery = DispatchQueue(label: "benchmarks.transport.delivery")
+        let session = URLSession(configuration: .ephemeral)
+        let rest = CharacterApiService(session: session, baseURL: server.baseURL, scheduler: CoreSchedulers.queue(delivery), tracer: nil)
+        let listProjection = CharacterProjection.list.adding(.episodeIDs)
+        let graphQL = GraphQLCharacterService(session: session,
+                                              baseURL: server.baseURL,
+                                              projection: listProjection,
+                                              scheduler: CoreSchedulers.queue(delivery),
+                                              tracer: nil)
+
+        let restPage = Fixtures.data("character-page-1.json")
+        func graphQLPage(_ projection: CharacterProjection) throws -> Data {
+            let request = ["query": "query { characters(page: 1) { results { \(projection.selection) } } }"]
+            guard let page = server.graphQLResponse(to: try JSONSerialization.data(withJSONObject: request)) else {
+                throw ServiceError.decode
+            }
+            return page
+        }
+        let listPage = try graphQLPage(.list)
+        let listWithEpisodesPage = try graphQLPage(listProjection)
+
+        let counters: () -> [String: Double] = {
+            let counters = ["requests": Double(server.requestCount), "bytes": Double(server.bytesSent)]
+            server.resetCounters()
+            return counters
+        }
+
+        return [
+            Benchmark(suite: "transport", name: "REST page decode", items: 20, bytes: restPage.count) {
+                blackHole(try JSONDecoder().decode(CharacterData.self, from: restPage))
+            },
+            Benchmark(suite: "transport", name: "GraphQL list page decode", items: 20, bytes: listPage.count) {
+                blackHole(try GraphQLCharacterService.decode(listPage))
+            },
+            Benchmark(suite: "transport", name: "GraphQL list page decode (with episode ids)", items: 20, bytes: listWithEpisodesPage.count) {
+                blackHole(try GraphQLCharacterService.decode(listWithEpisodesPage))
+            },
+            Benchmark(suite: "transport", name: "REST fetchCharacters", items: 20, counters: counters) {
+                blackHole(try rest.fetchCharacters().waitForValue())
+            },
+            Benchmark(suite: "transport", name: "GraphQL fetchCharacters", items: 20, counters: counters) {
+                blackHole(try graphQL.fetchCharacters().waitForValue())
+            },
+            Benchmark(suite: "transport", name: "REST searchCharacter", counters: counters) {
+                blackHole(try rest.searchCharacter(with: "name=rick").waitForValue())
+            },
+            Benchmark(suite: "transport", name: "GraphQL searchCharacter", counters: counters) {
+                blackHole(try graphQL.searchCharacter(with: "name=rick").waitForValue())
+            }
+        ]
+    }
+}
@@ -0,0 +1,134 @@
+//
+//  main.swift
+//  Benchmarks
+//
+//  Created by agent on 19/10/26.
+//
+//  swift run -c release Benchmarks [--filter <text>] [--min-time <seconds>] [--output <file.json>] [--list]
+//                                  [--startup-budget <budget.json>] [--startup-trace <trace.json>]
+//                                  [--startup-baseline <trace.json>] [--tuning <tuning.json>]
+//
+//  Writes a JSON report (see `BenchmarkReport`) to stdout, or to `--output`, and a
+//  human readable summary to stderr.
+//
+//  The median trace of the simulated launches can be written with `--startup-trace` and
+//  compared against an earlier one with `--startup-baseline`. With `--startup-budget`
+//  (e.g. `startup-budget.json` at the package root) the run exits with status 2 when a
+//  phase goes over its budget.
+//
+//  `--tuning` reads experiment knobs (page size, debounce...) from a JSON object of variable
+//  name -> value, like `tuning.json` at the package root, instead of their defaults.
+//
+
+import Foundation
+import RickAndMortyCore
+
+var configuration = BenchmarkConfiguration()
+var outputPath: String?
+var listOnly = false
+var startupBudgetPath: String?
+var startupTracePath: String?
+var startupBaselinePath: String?
+var tuningPath: String?
+
+var arguments = CommandLine.arguments.dropFirst().makeIterator()
+while let argument = arguments.next() {
+    switch argument {
+    case "--filter":
+        configuration.filter = arguments.next()
+    case "--min-time":
+        configuration.minDuration = arguments.next().flatMap(TimeInterval.init) ?? configuration.minDuration
+    case "--iterations":
+        configuration.minIterations = arguments.next().flatMap(Int.init) ?? configuration.minIterations
+    case "--output":
+        outputPath = arguments.next()
+    case "--list":
+        listOnly = true
+    case "--startup-budget":
+        startupBudgetPath = arguments.next()
+    case "--startup-trace":
+        startupTracePath = arguments.next()
+    case "--startup-baseline":
+        startupBaselinePath = arguments.next()
+    case "--tuning":
+        tuningPath = arguments.next()
+    default:
+        FileHandle.standardError.write(Data("Unknown argument \(argument)\n".utf8))
+        exit(64)
+    }
+}
+
+func printError(_ message: String) {
+    FileHandle.standardError.write(Data((message + "\n").utf8))
+}
+
+do {
+    let server = StubHTTPServer()
+    try server.start()
+    defer { server.stop() }
+
+    let tuning = try tuningPath.map { ExperimentConfig(source: try LocalExperimentValueSource(contentsOf: URL(fileURLWithPath: $0))) }
+        ?? .defaults
+    let startupTraces = StartupTraceRecorder()
+    let benchmarks = try DecodeBenchmarks.make()
+        + GraphBenchmarks.make()
+        + RowBenchmarks.make()
+        + SnapshotBenchmarks.make()
+        + FilterBenchmarks.make()
+        + SearchBenchmarks.make()
+        + SortBenchmarks.make()
+        + ExperimentBenchmarks.make()
+        + AnalyticsBenchmarks.make()
+        + PipelineBenchmarks.make(server: server, tuning: tuning)
+        + TransportBenchmarks.make(server: server)
+        + ReplayBenchmarks.make()
+        + SyncBenchmarks.make(server: server)
+        + StartupBenchmarks.make(server: server, recorder: startupTraces)
+
+    let runner = BenchmarkRunner(configuration: configuration)
+    var results = [BenchmarkResult]()
+
+    for benchmark in benchmarks where runner.shouldRun(benchmark) {
+        if listOnly {
+            print(benchmark.identifier)
+            continue
+        }
+        let result = try runner.run(benchmark)
+        printError(result.summary)
+        results.append(result)
+    }
+
+    if !listOnly {
+        let report = try BenchmarkReport(results: results).encoded()
+        if let outputPath = outputPath {
+            try report.write(to: URL(fileURLWithPath: outputPath))
+        } else {
+            FileHandle.standardOutput.write(report)
+        }
+    }
+
+    if let trace = startupTraces.median {
+        if let path = startupTracePath {
+            try trace.encoded().write(to: URL(fileURLWithPath: path))
+        }
+        if let path = startupBaselinePath {
+            let baseline = try JSONDecoder().decode(StartupTrace.self, from: Data(contentsOf: URL(fileURLWithPath: path)))
+            for (phase, milliseconds) in trace.differences(from: baseline) {
+                printError(String(format: "startup/%@: %+.2f ms vs baseline", phase.rawValue, milliseconds))
+            }
+        }
+        if let path = startupBudgetPath {
+            let budget = try JSONDecoder().decode(StartupBudget.self, from: Data(contentsOf: URL(fileURLWithPath: path)))
+            let violations = budget.violations(in: trace)
+            for violation in violations {
+                printError("Startup budget exceeded: \(violation)")
+            }
+            if !violations.isEmpty {
+                exit(2)
+            }
+        }
+    }
+} catch {
+    printError("Benchmark run failed: \(error)")
+    exit(1)
+}
@@ -0,0 +1,134 @@
+//
+//  Analytics.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import Atomics
+
+/// Receives summarized metrics, e.g. to forward them to `Apptimize.track`. Called on the
+/// analytics queue, never on the main thread.
+public protocol AnalyticsSink: AnyObject {
+    func send(_ summary: AnalyticsSummary)
+}
+
+/// Keeps every flushed summary in memory; for benchmarks and local runs.
+public final class LocalAnalyticsSink: AnalyticsSink {
+    private let lock = NSLock()
+    private var _summaries = [AnalyticsSummary]()
+
+    public init() {}
+
+    public var summaries: [AnalyticsSummary] {
+        lock.lock(); defer { lock.unlock() }
+        return _summaries
+    }
+
+    public func send(_ summary: AnalyticsSummary) {
+        lock.lock(); defer { lock.unlock() }
+        _summaries.append(summary)
+    }
+}
+
+/// Off-main analytics pipeline.
+///
+/// `record` pushes a fixed-size event into a lock-free ring buffer and returns; it is safe to
+/// call from any thread, including the main thread during scrolling. A background queue drains
+/// the buffer into counters and histograms and hands a summary to the sink every
+/// `flushInterval` seconds, so the sink sees one call per metric per flush instead of one per event.
+public final class Analytics {
+    private let buffer: EventRingBuffer<AnalyticsEvent>
+    private let sink: AnalyticsSink?
+    private let flushInterval: TimeInterval
+    private let queue: DispatchQueue
+    private let dropped = ManagedAtomic<Int>(0)
+    private var pending = AnalyticsSummary()
+    private var timer: DispatchSourceTimer?
+
+    /// - Parameter sink: `nil` aggregates and discards, which is what tests and benchmarks that
+    ///   only care about the recording cost want.
+    public init(sink: AnalyticsSink?,
+                capacity: Int = 4096,
+                flushInterval: TimeInterval = 30,
+                queue: DispatchQueue = DispatchQueue(label: "RickAndMortyCore.analytics", qos: .utility)) {
+        self.buffer = EventRingBuffer(capacity: capacity)
+        self.sink = sink
+        self.flushInterval = flushInterval
+        self.queue = queue
+    }
+
+    deinit {
+        timer?.cancel()
+    }
+
+    public func record(_ metric: AnalyticsMetric, value: Double = 1) {
+        if !buffer.push(AnalyticsEvent(metric: metric, value: value)) {
+            dropped.wrappingIncrement(ordering: .relaxed)
+        }
+    }
+
+    /// Starts flushing on the background cadence. Also drains every half interval so a burst
+    /// (a fast fling) cannot fill the buffer between two flushes.
+    public func start() {
+        guard timer == nil else { return }
+        let timer = DispatchSource.makeTimerSource(queue: queue)
+        let interval = max(flushInterval / 2, 0.1)
+        var ticks = 0
+        timer.schedule(deadline: .now() + interval, repeating: interval, leeway: .milliseconds(500))
+        timer.setEventHandler { [weak self] in
+            self?.drain()
+            ticks += 1
+            if ticks % 2 == 0 {
+                self?.send()
+            }
+        }
+        timer.resume()
+        self.timer = timer
+    }
+
+    public func stop() {
+        timer?.cancel()
+        timer = nil
+    }
+
+    /// Tags everything recorded from now on with `variant`. Events recorded before the switch
+    /// are flushed under the previous variant.
+    public func setVariant(_ variant: String?) {
+        queue.async { [weak self] in
+            guard let self = self, self.pending.variant != variant else { return }
+            self.drain()
+            self.send()
+            self.pending.variant = variant
+        }
+    }
+
+    /// Drains and sends everything recorded so far, e.g. when the app moves to the background.
+    public func flush(wait: Bool = false) {
+        let work = { [weak self] in
+            self?.drain()
+            self?.send()
+        }
+        if wait {
+            queue.sync(execute: work)
+        } else {
+            queue.async(execute: work)
+        }
+    }
+
+    private func drain() {
+        while let event = buffer.pop() {
+            pending.add(event)
+        }
+    }
+
+    private func send() {
+        pending.droppedEvents += dropped.exchange(0, ordering: .relaxed)
+        guard !pending.isEmpty else { return }
+        let summary = pending
+        pending = AnalyticsSummary()
+        pending.variant = summary.variant
+        sink?.send(summary)
+    }
+}
@@ -0,0 +1,129 @@
+//
+//  AnalyticsMetric.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Everything the app measures. Counters are summed between flushes; histograms keep the
+/// distribution of recorded values.
+public enum AnalyticsMetric: Int, CaseIterable {
+    public enum Kind {
+        case counter
+        case histogram
+    }
+
+    /// Deepest row index displayed in the character list.
+    case scrollDepth
+    /// Milliseconds from a search keystroke being debounced to its results arriving.
+    case searchLatency
+    case firstSeenCacheHit
+    case firstSeenCacheMiss
+    /// Milliseconds from `fetchCharacters()` to the first rows being available.
+    case pageLoadLatency
+    /// Resident memory of the process in megabytes, sampled periodically.
+    case memoryFootprint
+    /// Microseconds spent configuring one list cell in `cellForRowAt`.
+    case cellConfigureTime
+    /// Megabytes held by the caches registered with `CacheBudgetManager`, sampled with `memoryFootprint`.
+    case cacheFootprint
+    /// Kilobytes downloaded by one catalogue delta refresh.
+    case refreshTransfer
+    /// Milliseconds of hitches per second of one scroll of the character list, see `HitchReport`.
+    case hitchTimeRatio
+
+    public var name: String {
+        switch self {
+        case .scrollDepth: return "scroll_depth"
+        case .searchLatency: return "search_latency_ms"
+        case .firstSeenCacheHit: return "first_seen_cache_hit"
+        case .firstSeenCacheMiss: return "first_seen_cache_miss"
+        case .pageLoadLatency: return "page_load_latency_ms"
+        case .memoryFootprint: return "memory_footprint_mb"
+        case .cellConfigureTime: return "cell_configure_us"
+        case .cacheFootprint: return "cache_footprint_mb"
+        case .refreshTransfer: return "refresh_transfer_kb"
+        case .hitchTimeRatio: return "hitch_time_ratio_ms_per_s"
+        }
+    }
+
+    public var kind: Kind {
+        switch self {
+        case .scrollDepth, .searchLatency, .pageLoadLatency, .memoryFootprint, .cellConfigureTime, .cacheFootprint, .refreshTransfer,
+             .hitchTimeRatio:
+            return .histogram
+        case .firstSeenCacheHit, .firstSeenCacheMiss: return .counter
+        }
+    }
+}
+
+/// One recorded value; plain data, so pushing it through the ring buffer never retains anything.
+struct AnalyticsEvent {
+    let metric: AnalyticsMetric
+    let value: Double
+}
+
+/// Distribution of values in power-of-two buckets: bucket `i` holds values up to `2^i`.
+public struct AnalyticsHistogram: Equatable {
+    static let bucketCount = 32
+
+    public private(set) var count = 0
+    public private(set) var sum = 0.0
+    public private(set) var minimum = Double.infinity
+    public private(set) var maximum = -Double.infinity
+    private var buckets = [Int](repeating: 0, count: AnalyticsHistogram.bucketCount)
+
+    public init() {}
+
+    public mutating func record(_ value: Double) {
+        count += 1
+        sum += value
+        minimum = min(minimum, value)
+        maximum = max(maximum, value)
+        let bucket = value <= 1 ? 0 : Int(log2(value).rounded(.up))
+        buckets[min(bucket, AnalyticsHistogram.bucketCount - 1)] += 1
+    }
+
+    public var mean: Double {
+        return count == 0 ? 0 : sum / Double(count)
+    }
+
+    /// Upper bound of the bucket holding the `q` quantile, clamped to the recorded range.
+    public func quantile(_ q: Double) -> Double {
+        guard count > 0 else { return 0 }
+        let rank = Int((q * Double(count)).rounded(.up))
+        var seen = 0
+        for (bucket, bucketCount) in buckets.enumerated() {
+            seen += bucketCount
+            if seen >= max(rank, 1) {
+                return min(max(pow(2, Double(bucket)), minimum), maximum)
+            }
+        }
+        return maximum
+    }
+}
+
+/// Everything recorded between two flushes.
+public struct AnalyticsSummary: Equatable {
+    public var counters = [AnalyticsMetric: Double]()
+    public var histograms = [AnalyticsMetric: AnalyticsHistogram]()
+    /// Events lost because the buffer was full.
+    public var droppedEvents = 0
+    /// Experiment variant the events were recorded under, see `Analytics.setVariant(_:)`.
+    public var variant: String?
+
+    public init() {}
+
+    public var isEmpty: Bool {
+        return counters.isEmpty && histograms.isEmpty && droppedEvents == 0
+    }
+
+    mutating func add(_ event: AnalyticsEvent) {
+        switch event.metric.kind {
+        case .counter: counters[event.metric, default: 0] += event.value
+        case .histogram: histograms[event.metric, default: AnalyticsHistogram()].record(event.value)
+        }
+    }
+}
@@ -0,0 +1,78 @@
+//
+//  EventRingBuffer.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import Atomics
+
+/// Bounded, lock-free multi-producer / single-consumer queue (Vyukov's sequence-numbered ring).
+///
+/// `push` may be called from any thread and never blocks: when the ring is full the element is
+/// dropped and `push` returns `false`. `pop` must only be called from one thread at a time.
+final class EventRingBuffer<Element> {
+    private final class Slot {
+        /// Equal to the slot's position when free, position + 1 once written.
+        let sequence: ManagedAtomic<Int>
+        var element: Element?
+
+        init(sequence: Int) {
+            self.sequence = ManagedAtomic(sequence)
+        }
+    }
+
+    private let slots: [Slot]
+    private let mask: Int
+    private let enqueuePosition = ManagedAtomic<Int>(0)
+    private var dequeuePosition = 0
+
+    /// - Parameter capacity: rounded up to a power of two.
+    init(capacity: Int) {
+        var size = 2
+        while size < capacity {
+            size <<= 1
+        }
+        slots = (0..<size).map(Slot.init(sequence:))
+        mask = size - 1
+    }
+
+    var capacity: Int {
+        return slots.count
+    }
+
+    @discardableResult
+    func push(_ element: Element) -> Bool {
+        var position = enqueuePosition.load(ordering: .relaxed)
+        while true {
+            let slot = slots[position & mask]
+            let difference = slot.sequence.load(ordering: .acquiring) - position
+            if difference == 0 {
+                let (exchanged, original) = enqueuePosition.compareExchange(expected: position,
+                                                                            desired: position + 1,
+                                                                            ordering: .relaxed)
+                if exchanged {
+                    slot.element = element
+                    slot.sequence.store(position + 1, ordering: .releasing)
+                    return true
+                }
+                position = original
+            } else if difference < 0 {
+                return false
+            } else {
+                position = enqueuePosition.load(ordering: .relaxed)
+            }
+        }
+    }
+
+    func pop() -> Element? {
+        let slot = slots[dequeuePosition & mask]
+        guard slot.sequence.load(ordering: .acquiring) == dequeuePosition + 1 else { return nil }
+        let element = slot.element
+        slot.element = nil
+        slot.sequence.store(dequeuePosition + slots.count, ordering: .releasing)
+        dequeuePosition += 1
+        return element
+    }
+}
@@ -0,0 +1,36 @@
+//
+//  TrackingAnalyticsSink.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Forwards each flushed summary to `ExperimentPlatform.track`: counters as their total,
+/// histograms as their count, median, p90 and maximum, e.g. `search_latency_ms.p90`.
+///
+/// Event names are the bare metric names: the platform attributes events to the variant the
+/// device is enrolled in, so `AnalyticsSummary.variant` is not sent along.
+public final class TrackingAnalyticsSink: AnalyticsSink {
+    private let platform: ExperimentPlatform
+    
+    public init(platform: ExperimentPlatform) {
+        self.platform = platform
+    }
+    
+    public func send(_ summary: AnalyticsSummary) {
+        for (metric, total) in summary.counters {
+            platform.track(metric.name, value: total)
+        }
+        for (metric, histogram) in summary.histograms {
+            platform.track("\(metric.name).count", value: Double(histogram.count))
+            platform.track("\(metric.name).p50", value: histogram.quantile(0.5))
+            platform.track("\(metric.name).p90", value: histogram.quantile(0.9))
+            platform.track("\(metric.name).max", value: histogram.maximum)
+        }
+        if summary.droppedEvents > 0 {
+            platform.track("analytics_dropped_events", value: Double(summary.droppedEvents))
+        }
+    }
+}
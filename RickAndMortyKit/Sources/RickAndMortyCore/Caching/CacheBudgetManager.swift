@@ -0,0 +1,181 @@
+//
+//  CacheBudgetManager.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Keeps the in-memory caches (avatars, row models, row heights, episodes, locations) under one
+/// byte budget and trims them together on memory pressure.
+///
+/// Caches register how to report their cost and how to shrink to a fraction of it. Trimming
+/// is tiered by priority: cheap-to-rebuild data goes first, hot data (what is on screen) last.
+/// Registrations hold caches weakly and go away with them.
+public final class CacheBudgetManager {
+    /// Lower priorities are trimmed first and harder.
+    public enum Priority: Int, Comparable {
+        case low
+        case normal
+        case high
+
+        public static func < (lhs: Priority, rhs: Priority) -> Bool {
+            return lhs.rawValue < rhs.rawValue
+        }
+    }
+
+    public enum Pressure {
+        /// The app went to the background: drop what is cheap to rebuild.
+        case background
+        /// The system asked for memory back.
+        case warning
+        /// The system is about to terminate processes.
+        case critical
+
+        /// Fraction of each cache's cost kept after trimming.
+        func retainedFraction(for priority: Priority) -> Double {
+            switch (self, priority) {
+            case (.background, .low): return 0
+            case (.background, .normal): return 0.5
+            case (.background, .high): return 1
+            case (.warning, .low), (.warning, .normal): return 0
+            case (.warning, .high): return 0.5
+            case (.critical, _): return 0
+            }
+        }
+    }
+
+    public struct Usage {
+        public let name: String
+        public let priority: Priority
+        public let bytes: Int
+    }
+
+    private struct Registration {
+        let name: String
+        let priority: Priority
+        /// `nil` once the cache is gone.
+        let cost: () -> Int?
+        let trim: (Double) -> Void
+    }
+
+    private let lock = NSLock()
+    private var registrations = [Registration]()
+    #if canImport(Darwin)
+    private var pressureSource: DispatchSourceMemoryPressure?
+    #endif
+
+    /// Combined cost the caches are trimmed back to by `enforceBudget()`; 0 means unlimited.
+    public var budgetBytes: Int
+
+    /// Defaults to a 16th of the device's memory, at most 256 MB, so 2 GB devices keep 128 MB
+    /// of caches.
+    public init(budgetBytes: Int = CacheBudgetManager.defaultBudget) {
+        self.budgetBytes = budgetBytes
+    }
+
+    public static var defaultBudget: Int {
+        return Int(min(ProcessInfo.processInfo.physicalMemory / 16, 256 * 1024 * 1024))
+    }
+
+    /// Registers a cache by closures; `cost` returns `nil` once the cache is deallocated.
+    public func register(name: String, priority: Priority, cost: @escaping () -> Int?, trim: @escaping (_ retainedFraction: Double) -> Void) {
+        lock.lock(); defer { lock.unlock() }
+        registrations.append(Registration(name: name, priority: priority, cost: cost, trim: trim))
+    }
+
+    /// Registers a `MemoryCache`. Caches filled without costs pass `bytesPerEntry`, an estimate of
+    /// one entry's size, and are trimmed by count.
+    public func register<Key, Value>(_ cache: MemoryCache<Key, Value>, name: String, priority: Priority, bytesPerEntry: Int? = nil) {
+        register(name: name,
+                 priority: priority,
+                 cost: { [weak cache] in
+                    guard let cache = cache else { return nil }
+                    return bytesPerEntry.map { cache.count * $0 } ?? cache.totalCost
+                 },
+                 trim: { [weak cache] fraction in
+                    guard let cache = cache else { return }
+                    if bytesPerEntry != nil {
+                        cache.trim(toCount: Int(Double(cache.count) * fraction))
+                    } else {
+                        cache.trim(toCost: Int(Double(cache.totalCost) * fraction))
+                    }
+                 })
+    }
+
+    /// Current cost of every live cache, dropping the registrations of deallocated ones.
+    public var usage: [Usage] {
+        return liveRegistrations().map { Usage(name: $0.registration.name, priority: $0.registration.priority, bytes: $0.bytes) }
+    }
+
+    /// Combined cost of the registered caches, the footprint this manager accounts for.
+    public var totalBytes: Int {
+        return usage.reduce(0) { $0 + $1.bytes }
+    }
+
+    public func trim(for pressure: Pressure) {
+        for (registration, _) in liveRegistrations() {
+            let fraction = pressure.retainedFraction(for: registration.priority)
+            if fraction < 1 {
+                registration.trim(fraction)
+            }
+        }
+    }
+
+    /// Trims caches back under `budgetBytes`, lowest priority first; a priority is only touched
+    /// once every lower one is empty.
+    public func enforceBudget() {
+        guard budgetBytes > 0 else { return }
+        var live = liveRegistrations()
+        var total = live.reduce(0) { $0 + $1.bytes }
+
+        for priority in [Priority.low, .normal, .high] where total > budgetBytes {
+            let tier = live.filter { $0.registration.priority == priority }
+            let tierBytes = tier.reduce(0) { $0 + $1.bytes }
+            guard tierBytes > 0 else { continue }
+
+            let excess = total - budgetBytes
+            let fraction = max(0, Double(tierBytes - excess) / Double(tierBytes))
+            tier.forEach { $0.registration.trim(fraction) }
+            live = liveRegistrations()
+            total = live.reduce(0) { $0 + $1.bytes }
+        }
+    }
+
+    #if canImport(Darwin)
+    /// Trims on the kernel's memory pressure notifications, which also fire for extensions and
+    /// background processes that never see `didReceiveMemoryWarning`.
+    public func startMonitoringMemoryPressure(queue: DispatchQueue = .global(qos: .utility)) {
+        guard pressureSource == nil else { return }
+        let source = DispatchSource.makeMemoryPressureSource(eventMask: [.warning, .critical], queue: queue)
+        source.setEventHandler { [weak self, unowned source] in
+            self?.trim(for: source.data.contains(.critical) ? .critical : .warning)
+        }
+        source.resume()
+        pressureSource = source
+    }
+    #endif
+
+    private func liveRegistrations() -> [(registration: Registration, bytes: Int)] {
+        lock.lock()
+        let current = registrations
+        lock.unlock()
+
+        var live = [(registration: Registration, bytes: Int)]()
+        var deallocated = false
+        for registration in current {
+            if let bytes = registration.cost() {
+                live.append((registration, bytes))
+            } else {
+                deallocated = true
+            }
+        }
+        if deallocated {
+            lock.lock()
+            registrations.removeAll { $0.cost() == nil }
+            lock.unlock()
+        }
+        return live
+    }
+}
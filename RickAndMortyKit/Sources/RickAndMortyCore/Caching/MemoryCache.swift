@@ -0,0 +1,174 @@
+//
+//  MemoryCache.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Thread-safe least-recently-used cache with optional count and cost limits.
+public final class MemoryCache<Key: Hashable, Value> {
+    private final class Node {
+        let key: Key
+        var value: Value
+        var cost: Int
+        var newer: Node?
+        weak var older: Node?
+
+        init(key: Key, value: Value, cost: Int) {
+            self.key = key
+            self.value = value
+            self.cost = cost
+        }
+    }
+
+    private let lock = NSLock()
+    private var nodes = [Key: Node]()
+    /// Least recently used entry; eviction starts here.
+    private var oldest: Node?
+    /// Most recently used entry.
+    private weak var newest: Node?
+
+    private var _totalCost = 0
+    private var _hits = 0
+    private var _misses = 0
+
+    public var countLimit: Int
+    public var costLimit: Int
+
+    public init(countLimit: Int = 0, costLimit: Int = 0) {
+        self.countLimit = countLimit
+        self.costLimit = costLimit
+    }
+
+    deinit {
+        removeAllNodes()
+    }
+
+    public var count: Int {
+        lock.lock(); defer { lock.unlock() }
+        return nodes.count
+    }
+
+    public var totalCost: Int {
+        lock.lock(); defer { lock.unlock() }
+        return _totalCost
+    }
+
+    public var statistics: (hits: Int, misses: Int) {
+        lock.lock(); defer { lock.unlock() }
+        return (_hits, _misses)
+    }
+
+    public func value(forKey key: Key) -> Value? {
+        lock.lock(); defer { lock.unlock() }
+        guard let node = nodes[key] else {
+            _misses += 1
+            return nil
+        }
+        _hits += 1
+        moveToNewest(node)
+        return node.value
+    }
+
+    /// Returns the value `key` held before, if it was still cached.
+    @discardableResult
+    public func setValue(_ value: Value, forKey key: Key, cost: Int = 0) -> Value? {
+        lock.lock(); defer { lock.unlock() }
+        var previous: Value?
+        if let node = nodes[key] {
+            previous = node.value
+            _totalCost += cost - node.cost
+            node.value = value
+            node.cost = cost
+            moveToNewest(node)
+        } else {
+            let node = Node(key: key, value: value, cost: cost)
+            nodes[key] = node
+            _totalCost += cost
+            append(node)
+        }
+        evict(toCount: countLimit, cost: costLimit)
+        return previous
+    }
+
+    @discardableResult
+    public func removeValue(forKey key: Key) -> Value? {
+        lock.lock(); defer { lock.unlock() }
+        guard let node = nodes.removeValue(forKey: key) else { return nil }
+        unlink(node)
+        _totalCost -= node.cost
+        return node.value
+    }
+
+    public func removeAll() {
+        lock.lock(); defer { lock.unlock() }
+        removeAllNodes()
+    }
+
+    /// Evicts least recently used entries until the cache holds at most `cost`.
+    public func trim(toCost cost: Int) {
+        lock.lock(); defer { lock.unlock() }
+        evict(toCount: 0, cost: max(cost, 0), force: true)
+    }
+
+    /// Evicts least recently used entries until the cache holds at most `count` of them.
+    public func trim(toCount count: Int) {
+        lock.lock(); defer { lock.unlock() }
+        guard count > 0 else {
+            removeAllNodes()
+            return
+        }
+        evict(toCount: count, cost: 0)
+    }
+
+    private func evict(toCount countLimit: Int, cost costLimit: Int, force: Bool = false) {
+        while let node = oldest,
+              (countLimit > 0 && nodes.count > countLimit) || ((costLimit > 0 || force) && _totalCost > costLimit) {
+            nodes.removeValue(forKey: node.key)
+            unlink(node)
+            _totalCost -= node.cost
+        }
+    }
+
+    /// Unlinks the list one node at a time first: releasing its head would otherwise free the
+    /// whole `newer` chain recursively, one stack frame per entry.
+    private func removeAllNodes() {
+        while let node = oldest {
+            oldest = node.newer
+            node.newer = nil
+        }
+        newest = nil
+        nodes.removeAll()
+        _totalCost = 0
+    }
+
+    private func append(_ node: Node) {
+        node.older = newest
+        newest?.newer = node
+        newest = node
+        if oldest == nil {
+            oldest = node
+        }
+    }
+
+    private func unlink(_ node: Node) {
+        if oldest === node {
+            oldest = node.newer
+        }
+        if newest === node {
+            newest = node.older
+        }
+        node.older?.newer = node.newer
+        node.newer?.older = node.older
+        node.newer = nil
+        node.older = nil
+    }
+
+    private func moveToNewest(_ node: Node) {
+        guard newest !== node else { return }
+        unlink(node)
+        append(node)
+    }
+}
@@ -0,0 +1,60 @@
+//
+//  RowHeightCache.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Measured row heights keyed by character id and content size category (its raw value), so
+/// rows are measured once per Dynamic Type size instead of on every layout pass. Safe to fill
+/// from the background queue that builds row models while the table reads it on main.
+public final class RowHeightCache {
+    public struct Key: Hashable {
+        public let id: Int
+        public let category: String
+    }
+
+    public let cache: MemoryCache<Key, Double>
+    private let lock = NSLock()
+    /// Category -> (sum, count) of every height stored, for estimates of unmeasured rows.
+    private var totals = [String: (sum: Double, count: Int)]()
+
+    public init(countLimit: Int = 20_000) {
+        cache = MemoryCache(countLimit: countLimit)
+    }
+
+    public var count: Int {
+        return cache.count
+    }
+
+    public func height(forID id: Int, category: String) -> Double? {
+        return cache.value(forKey: Key(id: id, category: category))
+    }
+
+    public func setHeight(_ height: Double, forID id: Int, category: String) {
+        let previous = cache.setValue(height, forKey: Key(id: id, category: category))
+        lock.lock(); defer { lock.unlock() }
+        let total = totals[category] ?? (0, 0)
+        // Measuring a row again replaces its height in the mean rather than counting it twice.
+        if let previous = previous {
+            totals[category] = (total.sum + height - previous, total.count)
+        } else {
+            totals[category] = (total.sum + height, total.count + 1)
+        }
+    }
+
+    /// Mean of the heights measured at `category`, `nil` before the first measurement.
+    public func averageHeight(category: String) -> Double? {
+        lock.lock(); defer { lock.unlock() }
+        guard let total = totals[category], total.count > 0 else { return nil }
+        return total.sum / Double(total.count)
+    }
+
+    public func removeAll() {
+        cache.removeAll()
+        lock.lock(); defer { lock.unlock() }
+        totals.removeAll()
+    }
+}
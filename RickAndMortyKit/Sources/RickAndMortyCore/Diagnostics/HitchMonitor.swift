@@ -0,0 +1,173 @@
+//
+//  HitchMonitor.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(os)
+import os
+#endif
+
+/// Main-thread work that can make a frame miss its deadline while the list scrolls.
+public enum FrameWork: String, CaseIterable {
+    case cellConfigure
+    case imageDecode
+    case diffApply
+
+    #if canImport(os)
+    var signpostName: StaticString {
+        switch self {
+        case .cellConfigure: return "Cell configure"
+        case .imageDecode: return "Image decode"
+        case .diffApply: return "Diff apply"
+        }
+    }
+    #endif
+}
+
+/// Frame durations in fixed millisecond buckets around the 60 and 120 Hz frame budgets.
+public struct FrameTimeHistogram: Equatable {
+    /// Upper bound of each bucket in milliseconds; a last, open-ended bucket holds longer frames.
+    public static let bounds: [Double] = [8.4, 16.7, 25, 33.4, 50, 100, 250]
+
+    public private(set) var counts = [Int](repeating: 0, count: FrameTimeHistogram.bounds.count + 1)
+    public private(set) var count = 0
+    public private(set) var maximum = 0.0
+
+    public init() {}
+
+    public mutating func record(_ milliseconds: Double) {
+        let bucket = FrameTimeHistogram.bounds.firstIndex { milliseconds <= $0 } ?? FrameTimeHistogram.bounds.count
+        counts[bucket] += 1
+        count += 1
+        maximum = max(maximum, milliseconds)
+    }
+
+    /// Upper bound of the bucket holding the `q` quantile; the longest frame for the last bucket.
+    public func quantile(_ q: Double) -> Double {
+        guard count > 0 else { return 0 }
+        let rank = max(Int((q * Double(count)).rounded(.up)), 1)
+        var seen = 0
+        for (bucket, bucketCount) in counts.enumerated() {
+            seen += bucketCount
+            if seen >= rank {
+                return bucket < FrameTimeHistogram.bounds.count ? min(FrameTimeHistogram.bounds[bucket], maximum) : maximum
+            }
+        }
+        return maximum
+    }
+}
+
+/// Frames observed while scrolling, and the work that overlapped the ones that hitched.
+public struct HitchReport: Equatable {
+    public var frames = 0
+    public var hitches = 0
+    /// Seconds covered by the recorded frames.
+    public var duration: TimeInterval = 0
+    /// Milliseconds by which hitching frames overran their deadline.
+    public var hitchTime = 0.0
+    public var histogram = FrameTimeHistogram()
+    /// Hitch milliseconds of the frames each kind of work ran during. Work that only schedules
+    /// a cost for the frame's commit (setting an image decompresses it later) is still blamed.
+    /// A frame can overlap several kinds, so the values may add up to more than `hitchTime`.
+    public var attribution = [FrameWork: Double]()
+    /// Milliseconds each kind of work itself ran for during hitching frames.
+    public var overlap = [FrameWork: Double]()
+
+    public init() {}
+
+    /// Milliseconds of hitches per second of scrolling: under 5 is hardly noticeable, over 10
+    /// is visibly janky.
+    public var hitchTimeRatio: Double {
+        return duration > 0 ? hitchTime / duration : 0
+    }
+}
+
+/// Collects frame times from a display link and intervals of `FrameWork` from the code doing it,
+/// so each long frame is blamed on the work that ran during it.
+///
+/// Times are seconds of system uptime, the clock `CADisplayLink` timestamps use.
+public final class HitchMonitor {
+    public static let shared = HitchMonitor()
+    /// Intervals kept while no frames are recorded, e.g. cells configured before scrolling starts.
+    static let maxPendingIntervals = 1024
+
+    /// Overruns shorter than this are timing noise, not hitches.
+    public var tolerance: TimeInterval = 0.001
+
+    private let lock = NSLock()
+    private var intervals = [(work: FrameWork, start: TimeInterval, end: TimeInterval)]()
+    private var report = HitchReport()
+    #if canImport(os)
+    private let log = OSLog(subsystem: "RickAndMortyCore", category: .pointsOfInterest)
+    #endif
+
+    public init() {}
+
+    public static var now: TimeInterval {
+        return TimeInterval(DispatchTime.now().uptimeNanoseconds) / 1_000_000_000
+    }
+
+    /// Runs `body` as a signposted interval of `work`, kept for attributing the frames it overlaps.
+    @discardableResult
+    public func measure<T>(_ work: FrameWork, _ body: () throws -> T) rethrows -> T {
+        #if canImport(os)
+        let signpostID = OSSignpostID(log: log)
+        os_signpost(.begin, log: log, name: work.signpostName, signpostID: signpostID)
+        defer { os_signpost(.end, log: log, name: work.signpostName, signpostID: signpostID) }
+        #endif
+        let start = HitchMonitor.now
+        defer { record(work, start: start, end: HitchMonitor.now) }
+        return try body()
+    }
+
+    public func record(_ work: FrameWork, start: TimeInterval, end: TimeInterval) {
+        lock.lock(); defer { lock.unlock() }
+        if intervals.count >= HitchMonitor.maxPendingIntervals {
+            intervals.removeFirst(intervals.count / 2)
+        }
+        intervals.append((work, start, end))
+    }
+
+    /// One frame from `start` to `end` that was due `expected` seconds after `start`.
+    public func recordFrame(start: TimeInterval, end: TimeInterval, expected: TimeInterval) {
+        let duration = end - start
+        lock.lock(); defer { lock.unlock() }
+        report.frames += 1
+        report.duration += duration
+        report.histogram.record(duration * 1000)
+
+        let overrun = duration - expected
+        if overrun > tolerance {
+            report.hitches += 1
+            report.hitchTime += overrun * 1000
+            var blamed = Set<FrameWork>()
+            for interval in intervals where interval.start < end && interval.end > start {
+                report.overlap[interval.work, default: 0] += (min(end, interval.end) - max(start, interval.start)) * 1000
+                blamed.insert(interval.work)
+            }
+            for work in blamed {
+                report.attribution[work, default: 0] += overrun * 1000
+            }
+        }
+        // Later frames start after this one ends.
+        intervals.removeAll { $0.end <= end }
+    }
+
+    /// Frames recorded since the last call; starts a new report.
+    public func takeReport() -> HitchReport {
+        lock.lock(); defer { lock.unlock() }
+        let taken = report
+        report = HitchReport()
+        return taken
+    }
+
+    /// Drops recorded frames and intervals, e.g. when scrolling starts.
+    public func reset() {
+        lock.lock(); defer { lock.unlock() }
+        report = HitchReport()
+        intervals.removeAll()
+    }
+}
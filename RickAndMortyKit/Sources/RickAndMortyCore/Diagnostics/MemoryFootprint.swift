@@ -0,0 +1,52 @@
+//
+//  MemoryFootprint.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#endif
+
+public enum MemoryFootprint {
+    /// Memory attributed to this process: the physical footprint on Apple platforms (what jetsam
+    /// limits apply to), the resident set size on Linux.
+    public static var currentBytes: UInt64? {
+        #if canImport(Darwin)
+        return taskVMInfo?.phys_footprint
+        #else
+        guard let statm = try? String(contentsOfFile: "/proc/self/statm", encoding: .utf8) else { return nil }
+        let fields = statm.split(separator: " ")
+        guard fields.count > 1, let pages = UInt64(fields[1]) else { return nil }
+        return pages * UInt64(sysconf(Int32(_SC_PAGESIZE)))
+        #endif
+    }
+
+    /// Highest resident set size the process has reached. Unlike `currentBytes` it still counts
+    /// memory that was freed, and then reused by the allocator, since.
+    public static var peakBytes: UInt64? {
+        #if canImport(Darwin)
+        return taskVMInfo?.resident_size_peak
+        #else
+        guard let status = try? String(contentsOfFile: "/proc/self/status", encoding: .utf8),
+              let line = status.split(separator: "\n").first(where: { $0.hasPrefix("VmHWM:") }),
+              let kilobytes = line.split(whereSeparator: { $0 == " " || $0 == "\t" }).dropFirst().first.flatMap({ UInt64($0) }) else { return nil }
+        return kilobytes * 1024
+        #endif
+    }
+
+    #if canImport(Darwin)
+    private static var taskVMInfo: task_vm_info_data_t? {
+        var info = task_vm_info_data_t()
+        var count = mach_msg_type_number_t(MemoryLayout<task_vm_info_data_t>.size / MemoryLayout<integer_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(TASK_VM_INFO), $0, &count)
+            }
+        }
+        return result == KERN_SUCCESS ? info : nil
+    }
+    #endif
+}
@@ -0,0 +1,150 @@
+//
+//  StartupTracer.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#endif
+
+/// Milestones between process start and the first character row with its avatar on screen.
+public enum StartupPhase: String, CaseIterable, Codable {
+    case processStart
+    case didFinishLaunching
+    case charactersViewLoaded
+    case firstNetworkResponse
+    case firstDecode
+    case firstRowRendered
+    case firstAvatarRendered
+}
+
+/// Milliseconds from process start to each phase that was reached.
+///
+/// Encoded with sorted keys, so traces from two builds can be compared with a plain `diff`
+/// or with `differences(from:)`.
+public struct StartupTrace: Codable, Equatable {
+    public var revision: String?
+    public var phases: [String: Double]
+
+    public init(revision: String? = nil, phases: [String: Double] = [:]) {
+        self.revision = revision
+        self.phases = phases
+    }
+
+    public subscript(phase: StartupPhase) -> Double? {
+        get { return phases[phase.rawValue] }
+        set { phases[phase.rawValue] = newValue }
+    }
+
+    /// Per-phase change in milliseconds against `baseline`, for phases present in both.
+    public func differences(from baseline: StartupTrace) -> [(phase: StartupPhase, milliseconds: Double)] {
+        return StartupPhase.allCases.compactMap { phase in
+            guard let current = self[phase], let previous = baseline[phase] else { return nil }
+            return (phase, current - previous)
+        }
+    }
+
+    /// Per-phase median of several traces, e.g. repeated launches of the same build.
+    public static func median(of traces: [StartupTrace]) -> StartupTrace {
+        var median = StartupTrace(revision: traces.first?.revision)
+        for phase in StartupPhase.allCases {
+            let values = traces.compactMap { $0[phase] }.sorted()
+            guard !values.isEmpty else { continue }
+            median[phase] = values[values.count / 2]
+        }
+        return median
+    }
+
+    public func encoded() throws -> Data {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        return try encoder.encode(self)
+    }
+}
+
+/// Upper bound, in milliseconds since process start, for each budgeted phase.
+public struct StartupBudget: Codable {
+    public struct Violation: CustomStringConvertible {
+        public let phase: StartupPhase
+        public let milliseconds: Double
+        public let budget: Double
+
+        public var description: String {
+            return String(format: "%@: %.1f ms (budget %.1f ms)", phase.rawValue, milliseconds, budget)
+        }
+    }
+
+    public var phases: [String: Double]
+
+    public init(phases: [String: Double]) {
+        self.phases = phases
+    }
+
+    /// Budgeted phases the trace reached too late. Phases missing from the trace are not checked.
+    public func violations(in trace: StartupTrace) -> [Violation] {
+        return StartupPhase.allCases.compactMap { phase in
+            guard let budget = phases[phase.rawValue], let milliseconds = trace[phase], milliseconds > budget else { return nil }
+            return Violation(phase: phase, milliseconds: milliseconds, budget: budget)
+        }
+    }
+}
+
+/// Records when each `StartupPhase` is first reached. Later marks of the same phase are ignored,
+/// so call sites on hot paths (every response, every row) only pay for a lock.
+public final class StartupTracer {
+    public static let shared = StartupTracer(processStart: ProcessInfo.processInfo.processStartDate)
+
+    private let lock = NSLock()
+    /// Uptime, in nanoseconds, that phases are measured from.
+    private let origin: UInt64
+    private var marks = [StartupPhase: UInt64]()
+
+    /// - Parameter processStart: when the process started; defaults to now, which suits simulated launches.
+    public init(processStart: Date? = nil) {
+        let now = DispatchTime.now().uptimeNanoseconds
+        let elapsed = processStart.map { UInt64(max(0, Date().timeIntervalSince($0)) * 1_000_000_000) } ?? 0
+        origin = now - min(elapsed, now)
+        marks[.processStart] = origin
+    }
+
+    public var isComplete: Bool {
+        lock.lock(); defer { lock.unlock() }
+        return marks.count == StartupPhase.allCases.count
+    }
+
+    public func mark(_ phase: StartupPhase) {
+        let now = DispatchTime.now().uptimeNanoseconds
+        lock.lock(); defer { lock.unlock() }
+        guard marks[phase] == nil else { return }
+        marks[phase] = now
+    }
+
+    public func trace(revision: String? = nil) -> StartupTrace {
+        lock.lock(); defer { lock.unlock() }
+        var trace = StartupTrace(revision: revision)
+        for (phase, uptime) in marks {
+            trace[phase] = Double(uptime - origin) / 1_000_000
+        }
+        return trace
+    }
+}
+
+extension ProcessInfo {
+    /// Wall-clock time the kernel started this process, where the platform exposes it.
+    public var processStartDate: Date? {
+        #if canImport(Darwin)
+        var info = kinfo_proc()
+        var size = MemoryLayout<kinfo_proc>.stride
+        var mib: [Int32] = [CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()]
+        guard sysctl(&mib, u_int(mib.count), &info, &size, nil, 0) == 0 else { return nil }
+
+        let start = info.kp_proc.p_starttime
+        return Date(timeIntervalSince1970: TimeInterval(start.tv_sec) + TimeInterval(start.tv_usec) / 1_000_000)
+        #else
+        return nil
+        #endif
+    }
+}
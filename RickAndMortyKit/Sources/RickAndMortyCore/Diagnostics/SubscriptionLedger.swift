@@ -0,0 +1,92 @@
+//
+//  SubscriptionLedger.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Live subscription counts per name, so stress runs can assert that repeated loads do not leave
+/// sinks behind: a subscription is counted from the moment it is made until it completes or is
+/// cancelled.
+public final class SubscriptionLedger {
+    public static let shared = SubscriptionLedger()
+
+    private let lock = NSLock()
+    private var live = [String: Int]()
+    private var peaks = [String: Int]()
+
+    public init() {}
+
+    /// Subscriptions of `name` currently alive.
+    public func count(_ name: String) -> Int {
+        lock.lock(); defer { lock.unlock() }
+        return live[name] ?? 0
+    }
+
+    /// Subscriptions of every name currently alive.
+    public var total: Int {
+        lock.lock(); defer { lock.unlock() }
+        return live.values.reduce(0, +)
+    }
+
+    /// Most subscriptions of `name` alive at once since the ledger was created or reset.
+    public func peak(_ name: String) -> Int {
+        lock.lock(); defer { lock.unlock() }
+        return peaks[name] ?? 0
+    }
+
+    public func resetPeaks() {
+        lock.lock(); defer { lock.unlock() }
+        peaks = live
+    }
+
+    func open(_ name: String) -> Entry {
+        lock.lock(); defer { lock.unlock() }
+        let count = (live[name] ?? 0) + 1
+        live[name] = count
+        peaks[name] = max(peaks[name] ?? 0, count)
+        return Entry(name: name, ledger: self)
+    }
+
+    fileprivate func close(_ name: String) {
+        lock.lock(); defer { lock.unlock() }
+        live[name] = max(0, (live[name] ?? 0) - 1)
+    }
+
+    /// One counted subscription; closing it more than once has no effect.
+    final class Entry {
+        private let name: String
+        private weak var ledger: SubscriptionLedger?
+        private let lock = NSLock()
+        private var isOpen = true
+
+        init(name: String, ledger: SubscriptionLedger) {
+            self.name = name
+            self.ledger = ledger
+        }
+
+        func close() {
+            lock.lock()
+            let wasOpen = isOpen
+            isOpen = false
+            lock.unlock()
+            if wasOpen {
+                ledger?.close(name)
+            }
+        }
+    }
+}
+
+public extension Publisher {
+    /// Counts each subscription to this publisher in `ledger` under `name` while it is alive.
+    func tracked(as name: String, in ledger: SubscriptionLedger = .shared) -> AnyPublisher<Output, Failure> {
+        return Deferred { () -> Publishers.HandleEvents<Self> in
+            let entry = ledger.open(name)
+            return self.handleEvents(receiveCompletion: { _ in entry.close() },
+                                     receiveCancel: { entry.close() })
+        }
+        .eraseToAnyPublisher()
+    }
+}
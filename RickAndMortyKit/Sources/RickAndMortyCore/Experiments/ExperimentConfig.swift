@@ -0,0 +1,96 @@
+//
+//  ExperimentConfig.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Every experiment-driven setting, as plain stored values.
+///
+/// New settings are declared in `Variables` and read in `init(source:)`; hot paths such as
+/// `cellForRowAt` then read fields instead of going through the SDK.
+public struct ExperimentConfig: Equatable {
+    public enum Variables {
+        public static let showsFirstSeenIn = ExperimentVariable(name: "showsFirstSeenIn", defaultValue: true)
+        public static let prefetchesFirstSeenIn = ExperimentVariable(name: "prefetchesFirstSeenIn", defaultValue: true)
+        public static let usesGraphQLTransport = ExperimentVariable(name: "usesGraphQLTransport", defaultValue: false)
+        public static let usesFuzzySearch = ExperimentVariable(name: "usesFuzzySearch", defaultValue: false)
+        
+        // Pipeline tuning knobs.
+        public static let pageSize = ExperimentVariable(name: "pageSize", defaultValue: 20, bounds: 20...100)
+        public static let prefetchDepth = ExperimentVariable(name: "prefetchDepth", defaultValue: 0, bounds: 0...60)
+        public static let imageCacheMegabytes = ExperimentVariable(name: "imageCacheMegabytes", defaultValue: 50, bounds: 10...200)
+        public static let searchDebounceMilliseconds = ExperimentVariable(name: "searchDebounceMilliseconds", defaultValue: 500, bounds: 100...1000)
+    }
+    
+    /// Whether list rows show the "First seen in" episode.
+    public var showsFirstSeenIn: Bool
+    /// Whether rows about to scroll in resolve their first episode ahead of display.
+    public var prefetchesFirstSeenIn: Bool
+    /// Whether characters are fetched through `GraphQLCharacterService` with the list projection.
+    /// Read per request, see `ExperimentCharacterService`.
+    public var usesGraphQLTransport: Bool
+    /// Whether the search bar matches names locally, tolerating typos.
+    public var usesFuzzySearch: Bool
+    /// Rows the list loads at once; fetched as consecutive API pages of 20.
+    public var pageSize: Int
+    /// Extra rows past the ones UIKit prefetches whose first episode is resolved ahead of time.
+    public var prefetchDepth: Int
+    public var imageCacheMegabytes: Int
+    public var searchDebounceMilliseconds: Int
+    
+    public static let defaults = ExperimentConfig(source: LocalExperimentValueSource())
+    
+    public init(source: ExperimentValueSource) {
+        showsFirstSeenIn = source.value(of: Variables.showsFirstSeenIn)
+        prefetchesFirstSeenIn = source.value(of: Variables.prefetchesFirstSeenIn)
+        usesGraphQLTransport = source.value(of: Variables.usesGraphQLTransport)
+        usesFuzzySearch = source.value(of: Variables.usesFuzzySearch)
+        pageSize = Variables.pageSize.clamp(source.value(of: Variables.pageSize))
+        prefetchDepth = Variables.prefetchDepth.clamp(source.value(of: Variables.prefetchDepth))
+        imageCacheMegabytes = Variables.imageCacheMegabytes.clamp(source.value(of: Variables.imageCacheMegabytes))
+        searchDebounceMilliseconds = Variables.searchDebounceMilliseconds.clamp(source.value(of: Variables.searchDebounceMilliseconds))
+    }
+    
+    /// Identifies the combination of tuning knobs, so metrics can be reported per variant.
+    public var tuningVariant: String {
+        return "page\(pageSize)-prefetch\(prefetchDepth)-images\(imageCacheMegabytes)mb-debounce\(searchDebounceMilliseconds)ms"
+    }
+}
+
+/// Holds the current `ExperimentConfig`, refilled from its source each time the source
+/// reports a change. `current` is read and replaced on the store's scheduler (main by default).
+public final class ExperimentConfigStore {
+    private let source: ExperimentValueSource
+    private let subject: CurrentValueSubject<ExperimentConfig, Never>
+    private var bindings = Set<AnyCancellable>()
+    
+    public private(set) var current: ExperimentConfig
+    /// Number of times the source was read, i.e. SDK lookups per variable.
+    public private(set) var reloadCount = 0
+    
+    /// Emits the current config, then every config that differs from the previous one.
+    public var updates: AnyPublisher<ExperimentConfig, Never> {
+        return subject.removeDuplicates().eraseToAnyPublisher()
+    }
+    
+    public init(source: ExperimentValueSource, scheduler: CoreScheduler = CoreSchedulers.main) {
+        self.source = source
+        self.current = ExperimentConfig(source: source)
+        self.subject = CurrentValueSubject(current)
+        reloadCount = 1
+        
+        source.changes
+            .receive(on: scheduler)
+            .sink { [weak self] in self?.reload() }
+            .store(in: &bindings)
+    }
+    
+    public func reload() {
+        current = ExperimentConfig(source: source)
+        reloadCount += 1
+        subject.send(current)
+    }
+}
@@ -0,0 +1,201 @@
+//
+//  ExperimentPlatform.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// The experimentation SDK calls the app makes (`Apptimize` on device), behind a protocol so
+/// launch and experiment-dependent code can run against `LocalExperimentPlatform` instead.
+public protocol ExperimentPlatform: AnyObject {
+    /// Experiment variables, refreshed whenever new metadata arrives.
+    var variables: ExperimentValueSource { get }
+    /// Fires once the SDK is ready after `start`, with or without metadata.
+    var initialized: AnyPublisher<Void, Never> { get }
+    var isOffline: Bool { get }
+    
+    /// - Parameter timeout: how long `start` may block waiting for metadata; `0` never blocks.
+    func start(applicationKey: String, waitingForMetadataUpTo timeout: TimeInterval)
+    /// While offline nothing is downloaded or uploaded; may be called before `start`.
+    func setOffline(_ offline: Bool)
+    func track(_ event: String)
+    func track(_ event: String, value: Double)
+    func isFeatureFlagOn(_ name: String) -> Bool
+    /// Runs the block of the variant this device is enrolled in, or `baseline`. The SDK may keep
+    /// the blocks and run them after returning.
+    func runTest(_ name: String, baseline: @escaping () -> Void, variants: [String: () -> Void])
+}
+
+/// What the experiment servers would send down for this device.
+public struct ExperimentMetadata {
+    public var values: [String: Any]
+    public var enabledFeatureFlags: Set<String>
+    /// Test name -> variant this device is enrolled in.
+    public var enrolledVariants: [String: String]
+    
+    public init(values: [String: Any] = [:], enabledFeatureFlags: Set<String> = [], enrolledVariants: [String: String] = [:]) {
+        self.values = values
+        self.enabledFeatureFlags = enabledFeatureFlags
+        self.enrolledVariants = enrolledVariants
+    }
+}
+
+/// In-process stand-in for the experimentation SDK with a configurable metadata download.
+///
+/// After `start`, `metadata` "arrives" once `metadataLatency` has elapsed; a `nil` latency
+/// models a server that never answers, in which case `initialized` fires once the start timeout
+/// has elapsed. Until metadata arrives, variables read their defaults, feature flags are off and
+/// tests run their baseline. `setOffline(true)` cancels a pending download
+/// and holds tracked events back until going online again, as the SDK's offline mode does.
+public final class LocalExperimentPlatform: ExperimentPlatform {
+    public typealias TrackedEvent = (name: String, value: Double?)
+    
+    private let metadata: ExperimentMetadata
+    private let metadataLatency: TimeInterval?
+    private let queue: DispatchQueue
+    private let source = LocalExperimentValueSource()
+    private let initializedSubject = PassthroughSubject<Void, Never>()
+    private let condition = NSCondition()
+    
+    private var started = false
+    private var offline = false
+    private var metadataAvailable = false
+    /// Bumped whenever a pending download must be abandoned.
+    private var downloadGeneration = 0
+    private var pendingEvents = [TrackedEvent]()
+    private var uploadedEvents = [TrackedEvent]()
+    
+    public init(metadata: ExperimentMetadata = ExperimentMetadata(),
+                metadataLatency: TimeInterval? = 0,
+                queue: DispatchQueue = DispatchQueue(label: "RickAndMortyCore.local-experiments")) {
+        self.metadata = metadata
+        self.metadataLatency = metadataLatency
+        self.queue = queue
+    }
+    
+    public var variables: ExperimentValueSource {
+        return source
+    }
+    
+    public var initialized: AnyPublisher<Void, Never> {
+        return initializedSubject.eraseToAnyPublisher()
+    }
+    
+    public var isOffline: Bool {
+        condition.lock(); defer { condition.unlock() }
+        return offline
+    }
+    
+    public var isMetadataAvailable: Bool {
+        condition.lock(); defer { condition.unlock() }
+        return metadataAvailable
+    }
+    
+    /// Events that reached the "servers", in order.
+    public var trackedEvents: [TrackedEvent] {
+        condition.lock(); defer { condition.unlock() }
+        return uploadedEvents
+    }
+    
+    public func start(applicationKey: String, waitingForMetadataUpTo timeout: TimeInterval) {
+        condition.lock()
+        guard !started else {
+            condition.unlock()
+            return
+        }
+        started = true
+        let isOffline = offline
+        condition.unlock()
+        
+        if isOffline {
+            queue.async { self.initializedSubject.send(()) }
+            return
+        }
+        scheduleDownload()
+        if metadataLatency == nil {
+            // The SDK gives up on metadata after the start timeout and initializes without it.
+            queue.asyncAfter(deadline: .now() + timeout) { [weak self] in
+                self?.initializedSubject.send(())
+            }
+        }
+        
+        guard timeout > 0 else { return }
+        let deadline = Date(timeIntervalSinceNow: timeout)
+        condition.lock()
+        while !metadataAvailable && !offline && condition.wait(until: deadline) {}
+        condition.unlock()
+    }
+    
+    public func setOffline(_ offline: Bool) {
+        condition.lock()
+        self.offline = offline
+        downloadGeneration += 1
+        let resumeDownload = !offline && started && !metadataAvailable
+        if !offline {
+            uploadedEvents += pendingEvents
+            pendingEvents.removeAll()
+        }
+        condition.broadcast()
+        condition.unlock()
+        
+        if resumeDownload {
+            scheduleDownload()
+        }
+    }
+    
+    public func track(_ event: String) {
+        record((event, nil))
+    }
+    
+    public func track(_ event: String, value: Double) {
+        record((event, value))
+    }
+    
+    public func isFeatureFlagOn(_ name: String) -> Bool {
+        return isMetadataAvailable && metadata.enabledFeatureFlags.contains(name)
+    }
+    
+    public func runTest(_ name: String, baseline: @escaping () -> Void, variants: [String: () -> Void]) {
+        guard isMetadataAvailable, let variant = metadata.enrolledVariants[name], let block = variants[variant] else {
+            baseline()
+            return
+        }
+        block()
+    }
+    
+    private func record(_ event: TrackedEvent) {
+        condition.lock(); defer { condition.unlock() }
+        if offline {
+            pendingEvents.append(event)
+        } else {
+            uploadedEvents.append(event)
+        }
+    }
+    
+    private func scheduleDownload() {
+        guard let latency = metadataLatency else { return }
+        condition.lock()
+        let generation = downloadGeneration
+        condition.unlock()
+        
+        queue.asyncAfter(deadline: .now() + latency) { [weak self] in
+            guard let self = self, self.isCurrentDownload(generation) else { return }
+            // Values land before waiters in `start` are released, as with a blocking SDK start.
+            self.source.merge(self.metadata.values)
+            
+            self.condition.lock()
+            self.metadataAvailable = true
+            self.condition.broadcast()
+            self.condition.unlock()
+            
+            self.initializedSubject.send(())
+        }
+    }
+    
+    private func isCurrentDownload(_ generation: Int) -> Bool {
+        condition.lock(); defer { condition.unlock() }
+        return generation == downloadGeneration && !offline
+    }
+}
@@ -0,0 +1,101 @@
+//
+//  ExperimentValueSource.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Experiment variable declared at compile time, with the value used when no variant applies.
+public struct ExperimentVariable<Value> {
+    public let name: String
+    public let defaultValue: Value
+    /// Brings a served value back within the variable's safe range.
+    public let clamp: (Value) -> Value
+    
+    public init(name: String, defaultValue: Value) {
+        self.name = name
+        self.defaultValue = defaultValue
+        self.clamp = { $0 }
+    }
+}
+
+extension ExperimentVariable where Value: Comparable {
+    /// A variant serving a value outside `bounds` gets the nearest bound instead.
+    public init(name: String, defaultValue: Value, bounds: ClosedRange<Value>) {
+        self.name = name
+        self.defaultValue = defaultValue
+        self.clamp = { min(max($0, bounds.lowerBound), bounds.upperBound) }
+    }
+}
+
+/// Backend that experiment values are read from, e.g. the Apptimize SDK.
+///
+/// Lookups may be slow (name-keyed, through the SDK); `ExperimentConfigStore` only performs
+/// them when `changes` fires, never on hot paths.
+public protocol ExperimentValueSource: AnyObject {
+    func value(of variable: ExperimentVariable<Bool>) -> Bool
+    func value(of variable: ExperimentVariable<Int>) -> Int
+    func value(of variable: ExperimentVariable<Double>) -> Double
+    func value(of variable: ExperimentVariable<String>) -> String
+    /// Fires whenever values may have changed, e.g. once new experiment metadata arrived.
+    var changes: AnyPublisher<Void, Never> { get }
+}
+
+/// Values held in memory or loaded from a JSON object of name -> value: used on Linux, in
+/// benchmarks, and to exercise experiment-driven code without the vendor's servers.
+public final class LocalExperimentValueSource: ExperimentValueSource {
+    private let lock = NSLock()
+    private var values: [String: Any]
+    private let subject = PassthroughSubject<Void, Never>()
+    
+    public init(values: [String: Any] = [:]) {
+        self.values = values
+    }
+    
+    public convenience init(contentsOf url: URL) throws {
+        let object = try JSONSerialization.jsonObject(with: Data(contentsOf: url))
+        self.init(values: object as? [String: Any] ?? [:])
+    }
+    
+    public var changes: AnyPublisher<Void, Never> {
+        return subject.eraseToAnyPublisher()
+    }
+    
+    public func set(_ value: Any?, forName name: String) {
+        lock.lock()
+        values[name] = value
+        lock.unlock()
+        subject.send(())
+    }
+    
+    /// Replaces several values at once, reporting a single change.
+    public func merge(_ newValues: [String: Any]) {
+        lock.lock()
+        values.merge(newValues) { _, new in new }
+        lock.unlock()
+        subject.send(())
+    }
+    
+    public func value(of variable: ExperimentVariable<Bool>) -> Bool {
+        return lookup(variable.name) ?? variable.defaultValue
+    }
+    
+    public func value(of variable: ExperimentVariable<Int>) -> Int {
+        return lookup(variable.name) ?? variable.defaultValue
+    }
+    
+    public func value(of variable: ExperimentVariable<Double>) -> Double {
+        return lookup(variable.name) ?? variable.defaultValue
+    }
+    
+    public func value(of variable: ExperimentVariable<String>) -> String {
+        return lookup(variable.name) ?? variable.defaultValue
+    }
+    
+    private func lookup<Value>(_ name: String) -> Value? {
+        lock.lock(); defer { lock.unlock() }
+        return values[name] as? Value
+    }
+}
@@ -0,0 +1,135 @@
+//
+//  CharacterFacetIndex.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Character attributes the list can be filtered by.
+public enum CharacterFacet: String, CaseIterable {
+    case status
+    case species
+    case gender
+
+    public func value(of character: Character) -> String {
+        switch self {
+        case .status: return character.status
+        case .species: return character.species
+        case .gender: return character.gender
+        }
+    }
+}
+
+/// Selected values per facet: a character matches when, for every facet with a selection, its
+/// value is one of the selected ones.
+public struct CharacterFilter: Equatable {
+    public var selections: [CharacterFacet: Set<String>]
+
+    public static let none = CharacterFilter()
+
+    public init(_ selections: [CharacterFacet: Set<String>] = [:]) {
+        self.selections = selections.filter { !$0.value.isEmpty }
+    }
+
+    public var isEmpty: Bool {
+        return selections.isEmpty
+    }
+
+    public func isSelected(_ value: String, in facet: CharacterFacet) -> Bool {
+        return selections[facet]?.contains(value) ?? false
+    }
+
+    public func toggling(_ value: String, in facet: CharacterFacet) -> CharacterFilter {
+        var values = selections[facet] ?? []
+        if values.remove(value) == nil {
+            values.insert(value)
+        }
+        var selections = self.selections
+        selections[facet] = values
+        return CharacterFilter(selections)
+    }
+
+    public func matches(_ character: Character) -> Bool {
+        return selections.allSatisfy { facet, values in values.contains(facet.value(of: character)) }
+    }
+}
+
+public struct FacetValueCount: Equatable {
+    public let value: String
+    public let count: Int
+}
+
+/// One compressed bitmap of row numbers per facet value, built once for a list of characters.
+///
+/// A filter is the intersection of, per facet, the union of its selected values' bitmaps.
+/// A value's count is the popcount of its bitmap intersected with the other facets' selections,
+/// so it says how many rows selecting it would add (or keep) without running the filter.
+public final class CharacterFacetIndex {
+    public let characters: [Character]
+    private let bitmaps: [CharacterFacet: [String: CompressedBitmap]]
+
+    public init(characters: [Character]) {
+        self.characters = characters
+        var bitmaps = [CharacterFacet: [String: CompressedBitmap]]()
+        for facet in CharacterFacet.allCases {
+            var rows = [String: [Int]]()
+            for (row, character) in characters.enumerated() {
+                rows[facet.value(of: character), default: []].append(row)
+            }
+            bitmaps[facet] = rows.mapValues(CompressedBitmap.init(sortedRows:))
+        }
+        self.bitmaps = bitmaps
+    }
+
+    public var count: Int {
+        return characters.count
+    }
+
+    /// Values of `facet` found in the characters, most frequent first.
+    public func values(of facet: CharacterFacet) -> [String] {
+        return (bitmaps[facet] ?? [:])
+            .sorted { $0.value.count != $1.value.count ? $0.value.count > $1.value.count : $0.key < $1.key }
+            .map(\.key)
+    }
+
+    /// Rows matching `filter`, or `nil` when it selects nothing and every row matches.
+    public func rows(matching filter: CharacterFilter) -> CompressedBitmap? {
+        return rows(matching: filter, ignoring: nil)
+    }
+
+    public func characters(matching filter: CharacterFilter) -> [Character] {
+        guard let rows = rows(matching: filter) else { return characters }
+        return rows.rows.map { characters[$0] }
+    }
+
+    public func count(matching filter: CharacterFilter) -> Int {
+        return rows(matching: filter)?.count ?? characters.count
+    }
+
+    /// Per facet, every value with the number of rows it matches under the other facets' selections.
+    public func facetCounts(for filter: CharacterFilter) -> [CharacterFacet: [FacetValueCount]] {
+        var counts = [CharacterFacet: [FacetValueCount]]()
+        for facet in CharacterFacet.allCases {
+            let others = rows(matching: filter, ignoring: facet)
+            counts[facet] = values(of: facet).map { value in
+                let bitmap = bitmaps[facet]?[value] ?? CompressedBitmap()
+                return FacetValueCount(value: value, count: others.map(bitmap.intersectionCount) ?? bitmap.count)
+            }
+        }
+        return counts
+    }
+
+    private func rows(matching filter: CharacterFilter, ignoring ignored: CharacterFacet?) -> CompressedBitmap? {
+        var result: CompressedBitmap?
+        for facet in CharacterFacet.allCases where facet != ignored {
+            guard let values = filter.selections[facet] else { continue }
+            let facetRows = values.reduce(CompressedBitmap()) { rows, value in
+                bitmaps[facet]?[value].map(rows.union) ?? rows
+            }
+            result = result.map { $0.intersection(facetRows) } ?? facetRows
+        }
+        return result
+    }
+}
@@ -0,0 +1,284 @@
+//
+//  CompressedBitmap.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Set of row numbers, split in chunks of 65,536 rows. A chunk is stored as a sorted array of
+/// 16-bit offsets while it holds at most 4,096 rows, and as a 1,024-word bitset beyond that
+/// (the Roaring layout). Rare values stay small and common ones intersect a word at a time.
+public struct CompressedBitmap: Equatable {
+    enum Container: Equatable {
+        case array([UInt16])
+        case bitset([UInt64], count: Int)
+
+        var count: Int {
+            switch self {
+            case .array(let values): return values.count
+            case .bitset(_, let count): return count
+            }
+        }
+    }
+
+    static let arrayLimit = 4096
+    static let bitsetWords = 1024
+
+    /// High 16 bits of the rows in each container, ascending.
+    private(set) var keys = [UInt16]()
+    private(set) var containers = [Container]()
+
+    public init() {}
+
+    /// - Parameter rows: ascending row numbers.
+    public init<S: Sequence>(sortedRows rows: S) where S.Element == Int {
+        var pending = [UInt16]()
+        var key: UInt16?
+        for row in rows {
+            let high = UInt16(truncatingIfNeeded: row >> 16)
+            if high != key {
+                if let key = key {
+                    append(key, CompressedBitmap.container(sorted: pending))
+                }
+                key = high
+                pending.removeAll(keepingCapacity: true)
+            }
+            pending.append(UInt16(truncatingIfNeeded: row))
+        }
+        if let key = key {
+            append(key, CompressedBitmap.container(sorted: pending))
+        }
+    }
+
+    /// Rows `0..<count`.
+    public static func all(count: Int) -> CompressedBitmap {
+        return CompressedBitmap(sortedRows: 0..<count)
+    }
+
+    public var count: Int {
+        return containers.reduce(0) { $0 + $1.count }
+    }
+
+    public var isEmpty: Bool {
+        return containers.isEmpty
+    }
+
+    public var rows: [Int] {
+        var rows = [Int]()
+        rows.reserveCapacity(count)
+        for (key, container) in zip(keys, containers) {
+            let base = Int(key) << 16
+            switch container {
+            case .array(let values):
+                rows.append(contentsOf: values.map { base + Int($0) })
+            case .bitset(let words, _):
+                for (index, word) in words.enumerated() where word != 0 {
+                    var remaining = word
+                    while remaining != 0 {
+                        rows.append(base + index * 64 + remaining.trailingZeroBitCount)
+                        remaining &= remaining - 1
+                    }
+                }
+            }
+        }
+        return rows
+    }
+
+    public func contains(_ row: Int) -> Bool {
+        guard let position = position(of: UInt16(truncatingIfNeeded: row >> 16)) else { return false }
+        let low = UInt16(truncatingIfNeeded: row)
+        switch containers[position] {
+        case .array(let values): return CompressedBitmap.binarySearch(values, low)
+        case .bitset(let words, _): return words[Int(low) >> 6] & (1 << (UInt64(low) & 63)) != 0
+        }
+    }
+
+    public func intersection(_ other: CompressedBitmap) -> CompressedBitmap {
+        var result = CompressedBitmap()
+        forEachCommonContainer(with: other) { key, lhs, rhs in
+            let container = CompressedBitmap.intersect(lhs, rhs)
+            if container.count > 0 {
+                result.append(key, container)
+            }
+        }
+        return result
+    }
+
+    /// Size of the intersection, without building it: a popcount per word for dense chunks.
+    public func intersectionCount(_ other: CompressedBitmap) -> Int {
+        var count = 0
+        forEachCommonContainer(with: other) { _, lhs, rhs in
+            count += CompressedBitmap.intersectionCount(lhs, rhs)
+        }
+        return count
+    }
+
+    public func union(_ other: CompressedBitmap) -> CompressedBitmap {
+        var result = CompressedBitmap()
+        var i = 0
+        var j = 0
+        while i < keys.count || j < other.keys.count {
+            if j == other.keys.count || (i < keys.count && keys[i] < other.keys[j]) {
+                result.append(keys[i], containers[i])
+                i += 1
+            } else if i == keys.count || other.keys[j] < keys[i] {
+                result.append(other.keys[j], other.containers[j])
+                j += 1
+            } else {
+                result.append(keys[i], CompressedBitmap.unite(containers[i], other.containers[j]))
+                i += 1
+                j += 1
+            }
+        }
+        return result
+    }
+
+    private mutating func append(_ key: UInt16, _ container: Container) {
+        keys.append(key)
+        containers.append(container)
+    }
+
+    private func position(of key: UInt16) -> Int? {
+        var low = 0
+        var high = keys.count - 1
+        while low <= high {
+            let middle = (low + high) / 2
+            if keys[middle] == key { return middle }
+            if keys[middle] < key { low = middle + 1 } else { high = middle - 1 }
+        }
+        return nil
+    }
+
+    private func forEachCommonContainer(with other: CompressedBitmap, _ body: (UInt16, Container, Container) -> Void) {
+        var i = 0
+        var j = 0
+        while i < keys.count && j < other.keys.count {
+            if keys[i] < other.keys[j] {
+                i += 1
+            } else if other.keys[j] < keys[i] {
+                j += 1
+            } else {
+                body(keys[i], containers[i], other.containers[j])
+                i += 1
+                j += 1
+            }
+        }
+    }
+}
+
+// MARK: - Containers
+
+extension CompressedBitmap {
+    static func container(sorted values: [UInt16]) -> Container {
+        guard values.count > arrayLimit else { return .array(values) }
+        var words = [UInt64](repeating: 0, count: bitsetWords)
+        for value in values {
+            words[Int(value) >> 6] |= 1 << (UInt64(value) & 63)
+        }
+        return .bitset(words, count: values.count)
+    }
+
+    /// Dense results go back to an array once they are small enough.
+    static func container(words: [UInt64]) -> Container {
+        let count = words.reduce(0) { $0 + $1.nonzeroBitCount }
+        guard count <= arrayLimit else { return .bitset(words, count: count) }
+        var values = [UInt16]()
+        values.reserveCapacity(count)
+        for (index, word) in words.enumerated() where word != 0 {
+            var remaining = word
+            while remaining != 0 {
+                values.append(UInt16(index * 64 + remaining.trailingZeroBitCount))
+                remaining &= remaining - 1
+            }
+        }
+        return .array(values)
+    }
+
+    static func intersect(_ lhs: Container, _ rhs: Container) -> Container {
+        switch (lhs, rhs) {
+        case (.array(let a), .array(let b)):
+            var values = [UInt16]()
+            var i = 0
+            var j = 0
+            while i < a.count && j < b.count {
+                if a[i] < b[j] {
+                    i += 1
+                } else if b[j] < a[i] {
+                    j += 1
+                } else {
+                    values.append(a[i])
+                    i += 1
+                    j += 1
+                }
+            }
+            return .array(values)
+        case (.array(let values), .bitset(let words, _)), (.bitset(let words, _), .array(let values)):
+            return .array(values.filter { words[Int($0) >> 6] & (1 << (UInt64($0) & 63)) != 0 })
+        case (.bitset(let a, _), .bitset(let b, _)):
+            return container(words: zip(a, b).map { $0 & $1 })
+        }
+    }
+
+    static func intersectionCount(_ lhs: Container, _ rhs: Container) -> Int {
+        switch (lhs, rhs) {
+        case (.array, .array):
+            return intersect(lhs, rhs).count
+        case (.array(let values), .bitset(let words, _)), (.bitset(let words, _), .array(let values)):
+            var count = 0
+            for value in values where words[Int(value) >> 6] & (1 << (UInt64(value) & 63)) != 0 {
+                count += 1
+            }
+            return count
+        case (.bitset(let a, _), .bitset(let b, _)):
+            var count = 0
+            for index in 0..<bitsetWords {
+                count += (a[index] & b[index]).nonzeroBitCount
+            }
+            return count
+        }
+    }
+
+    static func unite(_ lhs: Container, _ rhs: Container) -> Container {
+        switch (lhs, rhs) {
+        case (.array(let a), .array(let b)):
+            var values = [UInt16]()
+            values.reserveCapacity(a.count + b.count)
+            var i = 0
+            var j = 0
+            while i < a.count || j < b.count {
+                if j == b.count || (i < a.count && a[i] < b[j]) {
+                    values.append(a[i])
+                    i += 1
+                } else if i == a.count || b[j] < a[i] {
+                    values.append(b[j])
+                    j += 1
+                } else {
+                    values.append(a[i])
+                    i += 1
+                    j += 1
+                }
+            }
+            return container(sorted: values)
+        case (.array(let values), .bitset(var words, _)), (.bitset(var words, _), .array(let values)):
+            for value in values {
+                words[Int(value) >> 6] |= 1 << (UInt64(value) & 63)
+            }
+            return container(words: words)
+        case (.bitset(let a, _), .bitset(let b, _)):
+            return container(words: zip(a, b).map { $0 | $1 })
+        }
+    }
+
+    static func binarySearch(_ values: [UInt16], _ value: UInt16) -> Bool {
+        var low = 0
+        var high = values.count - 1
+        while low <= high {
+            let middle = (low + high) / 2
+            if values[middle] == value { return true }
+            if values[middle] < value { low = middle + 1 } else { high = middle - 1 }
+        }
+        return false
+    }
+}
@@ -0,0 +1,106 @@
+//
+//  RelationshipGraph.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// In-memory character <-> episode <-> location graph keyed by id.
+///
+/// Edges are learned from whatever the repositories load: a character page alone is enough
+/// to answer "first episode of character Y", and an episode or location fetch fills in the
+/// reverse direction for characters that were never loaded.
+public final class RelationshipGraph {
+    private let lock = NSLock()
+    /// Character id -> episode ids in airing order.
+    private var episodesByCharacter = [Int: [Int]]()
+    private var charactersByEpisode = [Int: Set<Int>]()
+    private var locationByCharacter = [Int: Int]()
+    private var originByCharacter = [Int: Int]()
+    private var residentsByLocation = [Int: Set<Int>]()
+    
+    public init() {}
+    
+    public func ingest(_ characters: [Character]) {
+        lock.lock(); defer { lock.unlock() }
+        for character in characters {
+            let episodes = character.episodeIDs.sorted()
+            episodesByCharacter[character.id] = episodes
+            for episode in episodes {
+                charactersByEpisode[episode, default: []].insert(character.id)
+            }
+            if let previous = locationByCharacter[character.id] {
+                residentsByLocation[previous]?.remove(character.id)
+            }
+            if let location = character.locationID {
+                locationByCharacter[character.id] = location
+                residentsByLocation[location, default: []].insert(character.id)
+            }
+            originByCharacter[character.id] = character.originID
+        }
+    }
+    
+    public func ingest(_ episodes: [Episode]) {
+        lock.lock(); defer { lock.unlock() }
+        for episode in episodes {
+            let characters = episode.characterIDs
+            charactersByEpisode[episode.id, default: []].formUnion(characters)
+            for character in characters where episodesByCharacter[character]?.contains(episode.id) != true {
+                insertSorted(episode.id, into: &episodesByCharacter[character, default: []])
+            }
+        }
+    }
+    
+    public func ingest(_ locations: [Location]) {
+        lock.lock(); defer { lock.unlock() }
+        for location in locations {
+            guard let id = location.id else { continue }
+            let residents = location.residentIDs
+            residentsByLocation[id, default: []].formUnion(residents)
+            for resident in residents where locationByCharacter[resident] == nil {
+                locationByCharacter[resident] = id
+            }
+        }
+    }
+    
+    public func characters(inEpisode episode: Int) -> [Int] {
+        lock.lock(); defer { lock.unlock() }
+        return charactersByEpisode[episode]?.sorted() ?? []
+    }
+    
+    public func episodes(ofCharacter character: Int) -> [Int] {
+        lock.lock(); defer { lock.unlock() }
+        return episodesByCharacter[character] ?? []
+    }
+    
+    public func firstEpisode(ofCharacter character: Int) -> Int? {
+        lock.lock(); defer { lock.unlock() }
+        return episodesByCharacter[character]?.first
+    }
+    
+    public func location(ofCharacter character: Int) -> Int? {
+        lock.lock(); defer { lock.unlock() }
+        return locationByCharacter[character]
+    }
+    
+    public func origin(ofCharacter character: Int) -> Int? {
+        lock.lock(); defer { lock.unlock() }
+        return originByCharacter[character]
+    }
+    
+    public func residents(ofLocation location: Int) -> [Int] {
+        lock.lock(); defer { lock.unlock() }
+        return residentsByLocation[location]?.sorted() ?? []
+    }
+    
+    private func insertSorted(_ value: Int, into array: inout [Int]) {
+        var low = 0, high = array.count
+        while low < high {
+            let mid = (low + high) / 2
+            if array[mid] < value { low = mid + 1 } else { high = mid }
+        }
+        array.insert(value, at: low)
+    }
+}
@@ -0,0 +1,66 @@
+//
+//  Character.swift
+//  RickAndMortyCore
+//
+//  Created by omaestra on 16/6/21.
+//
+
+import Foundation
+
+public struct Character: Codable, Equatable {
+    public var id: Int
+    public var name: String
+    public var status: String
+    public var species: String
+    public var type: String
+    public var gender: String
+    public var origin: Location
+    public var location: Location
+    public var image: String
+    public var episode: [String]
+    public var url: String
+    public var created: String
+    
+    public init(id: Int,
+                name: String,
+                status: String,
+                species: String,
+                type: String,
+                gender: String,
+                origin: Location,
+                location: Location,
+                image: String,
+                episode: [String],
+                url: String,
+                created: String) {
+        self.id = id
+        self.name = name
+        self.status = status
+        self.species = species
+        self.type = type
+        self.gender = gender
+        self.origin = origin
+        self.location = location
+        self.image = image
+        self.episode = episode
+        self.url = url
+        self.created = created
+    }
+}
+
+/// The `info` block of a paged `/api/character` response.
+public struct PageInfo: Codable {
+    /// Characters in the whole catalogue.
+    public var count: Int
+    public var pages: Int
+    
+    public init(count: Int, pages: Int) {
+        self.count = count
+        self.pages = pages
+    }
+}
+
+public struct CharacterData: Codable {
+    public var info: PageInfo?
+    public var results: [Character]
+}
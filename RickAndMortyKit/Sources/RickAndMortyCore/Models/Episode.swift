@@ -1,27 +1,27 @@
 //
 //  Episode.swift
-//  RickAndMorty-Combine
+//  RickAndMortyCore
 //
 //  Created by omaestra on 16/6/21.
 //
 
 import Foundation
 
-struct Episode: Codable {
-    var id: Int
-    var name: String
-    var airDate: String
-    var episode: String
-    var characters: [String]
-    var url: String
-    var created: String
+public struct Episode: Codable {
+    public var id: Int
+    public var name: String
+    public var airDate: String
+    public var episode: String
+    public var characters: [String]
+    public var url: String
+    public var created: String
     
     private enum CodingKeys: String, CodingKey {
         case id, name, episode, characters, url, created
         case airDate = "air_date"
     }
     
-    init(from decoder: Decoder) throws {
+    public init(from decoder: Decoder) throws {
         let container = try decoder.container(keyedBy: CodingKeys.self)
         
         id = try container.decode(Int.self, forKey: .id)
@@ -0,0 +1,274 @@
+//
+//  LazyCharacter.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// A character whose list fields are decoded up front and everything else (species, origin,
+/// episodes...) only the first time `character` is read.
+///
+/// Each record keeps a slice of the response it came from, sharing the response's buffer, so
+/// a page costs one buffer plus the list strings until details are needed.
+public final class LazyCharacter {
+    public let id: Int
+    public let name: String
+    public let status: String
+    public let gender: String
+    public let image: String
+    public let locationName: String?
+    /// The record's JSON object.
+    public let record: Data
+
+    private let lock = NSLock()
+    private var decoded: Character?
+
+    init(id: Int, name: String, status: String, gender: String, image: String, locationName: String?, record: Data) {
+        self.id = id
+        self.name = name
+        self.status = status
+        self.gender = gender
+        self.image = image
+        self.locationName = locationName
+        self.record = record
+    }
+
+    public var isDecoded: Bool {
+        lock.lock(); defer { lock.unlock() }
+        return decoded != nil
+    }
+
+    /// The full record, decoded on first access and kept afterwards.
+    public func character() throws -> Character {
+        lock.lock(); defer { lock.unlock() }
+        if let decoded = decoded {
+            return decoded
+        }
+        let character = try JSONDecoder().decode(Character.self, from: record)
+        decoded = character
+        return character
+    }
+
+    /// Records of a `/api/character` response (`{"info": ..., "results": [...]}`), scanning the
+    /// bytes once and skipping every field the list does not show.
+    public static func decodePage(_ data: Data) throws -> [LazyCharacter] {
+        let ranges = try data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> [(Range<Int>, ListFields)] in
+            var scanner = JSONScanner(bytes: buffer.bindMemory(to: UInt8.self))
+            var records = [(Range<Int>, ListFields)]()
+            try scanner.members { key, scanner in
+                guard key == "results" else { return try scanner.skipValue() }
+                try scanner.elements { scanner in
+                    let start = scanner.index
+                    let fields = try scanner.listFields()
+                    records.append((start..<scanner.index, fields))
+                }
+            }
+            return records
+        }
+
+        return try ranges.map { range, fields in
+            guard let id = fields.id, let name = fields.name else { throw ServiceError.decode }
+            let start = data.startIndex + range.lowerBound
+            return LazyCharacter(id: id,
+                                 name: name,
+                                 status: fields.status ?? "",
+                                 gender: fields.gender ?? "",
+                                 image: fields.image ?? "",
+                                 locationName: fields.locationName,
+                                 record: data[start..<start + range.count])
+        }
+    }
+}
+
+struct ListFields {
+    var id: Int?
+    var name: String?
+    var status: String?
+    var gender: String?
+    var image: String?
+    var locationName: String?
+}
+
+/// Forward-only reader over JSON bytes that can skip whole values without building them.
+/// Only what `LazyCharacter` needs is supported; malformed input throws `ServiceError.decode`.
+private struct JSONScanner {
+    let bytes: UnsafeBufferPointer<UInt8>
+    var index = 0
+
+    init(bytes: UnsafeBufferPointer<UInt8>) {
+        self.bytes = bytes
+    }
+
+    mutating func listFields() throws -> ListFields {
+        var fields = ListFields()
+        try members { key, scanner in
+            switch key {
+            case "id": fields.id = try scanner.integer()
+            case "name": fields.name = try scanner.string()
+            case "status": fields.status = try scanner.string()
+            case "gender": fields.gender = try scanner.string()
+            case "image": fields.image = try scanner.string()
+            case "location":
+                try scanner.members { key, scanner in
+                    if key == "name" {
+                        fields.locationName = try scanner.string()
+                    } else {
+                        try scanner.skipValue()
+                    }
+                }
+            default: try scanner.skipValue()
+            }
+        }
+        return fields
+    }
+
+    /// Calls `body` with each key of the object at the current position; `body` must consume the value.
+    mutating func members(_ body: (String, inout JSONScanner) throws -> Void) throws {
+        try expect(UInt8(ascii: "{"))
+        skipWhitespace()
+        if try peek() == UInt8(ascii: "}") {
+            index += 1
+            return
+        }
+        while true {
+            skipWhitespace()
+            let key = try string()
+            skipWhitespace()
+            try expect(UInt8(ascii: ":"))
+            skipWhitespace()
+            try body(key, &self)
+            skipWhitespace()
+            let separator = try next()
+            if separator == UInt8(ascii: "}") { return }
+            guard separator == UInt8(ascii: ",") else { throw ServiceError.decode }
+        }
+    }
+
+    /// Calls `body` at each element of the array at the current position; `body` must consume it.
+    mutating func elements(_ body: (inout JSONScanner) throws -> Void) throws {
+        try expect(UInt8(ascii: "["))
+        skipWhitespace()
+        if try peek() == UInt8(ascii: "]") {
+            index += 1
+            return
+        }
+        while true {
+            skipWhitespace()
+            try body(&self)
+            skipWhitespace()
+            let separator = try next()
+            if separator == UInt8(ascii: "]") { return }
+            guard separator == UInt8(ascii: ",") else { throw ServiceError.decode }
+        }
+    }
+
+    mutating func string() throws -> String {
+        let start = index
+        try expect(UInt8(ascii: "\""))
+        var escaped = false
+        while true {
+            let byte = try next()
+            if byte == UInt8(ascii: "\"") { break }
+            if byte == UInt8(ascii: "\\") {
+                escaped = true
+                index += 1
+            }
+        }
+        guard escaped else {
+            return String(decoding: UnsafeBufferPointer(rebasing: bytes[start + 1..<index - 1]), as: UTF8.self)
+        }
+        // Rare: let Foundation resolve the escapes of this one string.
+        let fragment = Data(bytes[start..<index])
+        guard let value = try JSONSerialization.jsonObject(with: fragment, options: .fragmentsAllowed) as? String else {
+            throw ServiceError.decode
+        }
+        return value
+    }
+
+    mutating func integer() throws -> Int {
+        var value = 0
+        var negative = false
+        if try peek() == UInt8(ascii: "-") {
+            negative = true
+            index += 1
+        }
+        let start = index
+        while index < bytes.count, bytes[index] >= UInt8(ascii: "0"), bytes[index] <= UInt8(ascii: "9") {
+            value = value * 10 + Int(bytes[index] - UInt8(ascii: "0"))
+            index += 1
+        }
+        guard index > start else { throw ServiceError.decode }
+        return negative ? -value : value
+    }
+
+    mutating func skipValue() throws {
+        switch try peek() {
+        case UInt8(ascii: "\""):
+            try skipString()
+        case UInt8(ascii: "{"), UInt8(ascii: "["):
+            var depth = 0
+            repeat {
+                switch try peek() {
+                case UInt8(ascii: "\""):
+                    try skipString()
+                    continue
+                case UInt8(ascii: "{"), UInt8(ascii: "["):
+                    depth += 1
+                case UInt8(ascii: "}"), UInt8(ascii: "]"):
+                    depth -= 1
+                default:
+                    break
+                }
+                index += 1
+            } while depth > 0
+        default:
+            // Number, true, false or null.
+            while index < bytes.count {
+                switch bytes[index] {
+                case UInt8(ascii: ","), UInt8(ascii: "}"), UInt8(ascii: "]"),
+                     UInt8(ascii: " "), UInt8(ascii: "\n"), UInt8(ascii: "\r"), UInt8(ascii: "\t"):
+                    return
+                default:
+                    index += 1
+                }
+            }
+        }
+    }
+
+    private mutating func skipString() throws {
+        try expect(UInt8(ascii: "\""))
+        while true {
+            let byte = try next()
+            if byte == UInt8(ascii: "\"") { return }
+            if byte == UInt8(ascii: "\\") { index += 1 }
+        }
+    }
+
+    private mutating func skipWhitespace() {
+        while index < bytes.count {
+            switch bytes[index] {
+            case UInt8(ascii: " "), UInt8(ascii: "\n"), UInt8(ascii: "\r"), UInt8(ascii: "\t"):
+                index += 1
+            default:
+                return
+            }
+        }
+    }
+
+    private func peek() throws -> UInt8 {
+        guard index < bytes.count else { throw ServiceError.decode }
+        return bytes[index]
+    }
+
+    private mutating func next() throws -> UInt8 {
+        let byte = try peek()
+        index += 1
+        return byte
+    }
+
+    private mutating func expect(_ byte: UInt8) throws {
+        guard try next() == byte else { throw ServiceError.decode }
+    }
+}
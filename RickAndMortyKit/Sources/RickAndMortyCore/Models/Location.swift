@@ -0,0 +1,34 @@
+//
+//  Location.swift
+//  RickAndMortyCore
+//
+//  Created by omaestra on 16/6/21.
+//
+
+import Foundation
+
+public struct Location: Codable, Equatable {
+    public var id: Int?
+    public var name: String?
+    public var type: String?
+    public var dimension: String?
+    public var residents: [String]?
+    public var url: String?
+    public var created: String?
+    
+    public init(id: Int? = nil,
+                name: String? = nil,
+                type: String? = nil,
+                dimension: String? = nil,
+                residents: [String]? = nil,
+                url: String? = nil,
+                created: String? = nil) {
+        self.id = id
+        self.name = name
+        self.type = type
+        self.dimension = dimension
+        self.residents = residents
+        self.url = url
+        self.created = created
+    }
+}
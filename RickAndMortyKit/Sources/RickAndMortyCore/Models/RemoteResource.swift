@@ -0,0 +1,70 @@
+//
+//  RemoteResource.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// A model served under `/api/<endpoint>/<id>` that can also be fetched in batches with
+/// `/api/<endpoint>/<id>,<id>,...`.
+public protocol RemoteResource: Codable {
+    static var endpoint: String { get }
+    var resourceID: Int? { get }
+}
+
+extension Character: RemoteResource {
+    public static let endpoint = "character"
+    public var resourceID: Int? { return id }
+}
+
+extension Episode: RemoteResource {
+    public static let endpoint = "episode"
+    public var resourceID: Int? { return id }
+}
+
+extension Location: RemoteResource {
+    public static let endpoint = "location"
+    public var resourceID: Int? { return id }
+}
+
+enum ResourceURL {
+    /// Id at the end of a resource URL such as `https://rickandmortyapi.com/api/episode/28`.
+    static func id(from url: String) -> Int? {
+        guard let slash = url.lastIndex(of: "/") else { return nil }
+        return Int(url[url.index(after: slash)...])
+    }
+}
+
+public extension Character {
+    var episodeIDs: [Int] {
+        return episode.compactMap(ResourceURL.id(from:))
+    }
+    
+    /// The episode the character was first seen in. Episode ids follow air order, so this is the
+    /// lowest one, whatever order the API lists them in; `RelationshipGraph` agrees.
+    var firstEpisodeID: Int? {
+        return episodeIDs.min()
+    }
+    
+    var locationID: Int? {
+        return location.url.flatMap(ResourceURL.id(from:))
+    }
+    
+    var originID: Int? {
+        return origin.url.flatMap(ResourceURL.id(from:))
+    }
+}
+
+public extension Episode {
+    var characterIDs: [Int] {
+        return characters.compactMap(ResourceURL.id(from:))
+    }
+}
+
+public extension Location {
+    var residentIDs: [Int] {
+        return (residents ?? []).compactMap(ResourceURL.id(from:))
+    }
+}
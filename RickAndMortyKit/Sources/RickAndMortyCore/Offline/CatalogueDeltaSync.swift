@@ -0,0 +1,106 @@
+//
+//  CatalogueDeltaSync.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// What the delta sync knows about the remote catalogue, persisted with the store.
+public struct CatalogueSyncState: Codable, Equatable {
+    /// `info.count` at the last refresh.
+    public var count: Int
+    public var pages: Int
+    /// Next page to revalidate; pages are revalidated in rotation.
+    public var revalidationCursor: Int
+    
+    public init(count: Int, pages: Int, revalidationCursor: Int) {
+        self.count = count
+        self.pages = pages
+        self.revalidationCursor = revalidationCursor
+    }
+}
+
+public struct CatalogueRefresh {
+    public let count: Int
+    public let newCharacters: Int
+    public let revalidatedPages: [Int]
+    /// Traffic of the refresh, as seen by the meter (other requests running meanwhile included).
+    public let transfer: TransferMeter.Reading?
+}
+
+/// Refreshes a cached catalogue without downloading every page again.
+///
+/// Character ids are dense and only ever grow, so a refresh reads `info.count` from the last
+/// page, fetches the ids above the store's high-water mark (the end of its gapless pages, see
+/// `CharacterStore.catalogueHighWaterMark(pageSize:)`) through the multi-id endpoint, and
+/// revalidates a few already stored pages, a different few each time, to pick up edits.
+public final class CatalogueDeltaSync {
+    public static let pageSize = 20
+    
+    private let service: CharacterApiServiceProtocol
+    private let characters: ResourceApiService<Character>
+    private let store: CharacterStore
+    private let meter: TransferMeter?
+    private let revalidatedPagesPerRefresh: Int
+    
+    public init(service: CharacterApiServiceProtocol,
+                characters: ResourceApiService<Character> = ResourceApiService(),
+                store: CharacterStore,
+                meter: TransferMeter? = nil,
+                revalidatedPagesPerRefresh: Int = 2) {
+        self.service = service
+        self.characters = characters
+        self.store = store
+        self.meter = meter
+        self.revalidatedPagesPerRefresh = revalidatedPagesPerRefresh
+    }
+    
+    public func refresh() -> AnyPublisher<CatalogueRefresh, Error> {
+        let state = store.catalogueState
+        let highWaterMark = store.catalogueHighWaterMark(pageSize: CatalogueDeltaSync.pageSize)
+        let start = meter?.reading
+        
+        return service.fetchInfo(page: max(1, state?.pages ?? 1))
+            .flatMap { [service, characters, store, meter, revalidatedPagesPerRefresh] info -> AnyPublisher<CatalogueRefresh, Error> in
+                let newIDs = info.count > highWaterMark ? Array(highWaterMark + 1...info.count) : []
+                
+                // Only complete pages below the high-water mark; the one it falls in is refetched by id.
+                let storedPages = highWaterMark / CatalogueDeltaSync.pageSize
+                var cursor = state?.revalidationCursor ?? 0
+                var pages = [Int]()
+                for _ in 0..<min(revalidatedPagesPerRefresh, storedPages) {
+                    pages.append(cursor % storedPages + 1)
+                    cursor += 1
+                }
+                let nextState = CatalogueSyncState(count: info.count,
+                                                   pages: info.pages,
+                                                   revalidationCursor: storedPages > 0 ? cursor % storedPages : 0)
+                
+                // Captured with the requests: the transport, and with it the projection, may change
+                // before they answer.
+                let projection = service.projection
+                let revalidated: AnyPublisher<[(Int, [Character])], Error> = pages.isEmpty
+                    ? Just([]).setFailureType(to: Error.self).eraseToAnyPublisher()
+                    : Publishers.MergeMany(pages.map { page in service.fetchCharacters(page: page).map { (page, $0) } })
+                        .collect()
+                        .eraseToAnyPublisher()
+                
+                return characters.fetch(ids: newIDs)
+                    .zip(revalidated)
+                    .map { fetched, revalidated -> CatalogueRefresh in
+                        store.save(catalogue: fetched, state: nextState, pageSize: CatalogueDeltaSync.pageSize)
+                        for (page, characters) in revalidated {
+                            store.save(characters, page: page, projection: projection)
+                        }
+                        return CatalogueRefresh(count: info.count,
+                                                newCharacters: fetched.count,
+                                                revalidatedPages: pages,
+                                                transfer: start.flatMap { start in meter?.reading.since(start) })
+                    }
+                    .eraseToAnyPublisher()
+            }
+            .eraseToAnyPublisher()
+    }
+}
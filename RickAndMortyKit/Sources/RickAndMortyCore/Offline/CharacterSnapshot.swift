@@ -0,0 +1,318 @@
+//
+//  CharacterSnapshot.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Read-only binary copy of the character catalogue, meant to be memory-mapped at launch.
+///
+/// Opening a snapshot validates its header and every offset stored in the index and records,
+/// without decoding anything: records are read straight from the mapping when asked for, so the
+/// first page can be shown without decoding the whole catalogue, and a truncated or corrupt file
+/// is rejected up front instead of trapping on a later read.
+///
+/// Layout, all integers little-endian `UInt32`:
+///
+///     header   magic, version, count, record size, index offset, records offset,
+///              arena offset, arena length
+///     index    count × (id, record number), sorted by id
+///     records  count × record: id, then an (offset, length) pair into the arena per `Field`
+///     arena    UTF-8 bytes of every distinct string, each stored once
+///
+/// A `nil` string (an origin or location without a name or url) has length `0xFFFF_FFFF`.
+/// Episode urls are stored as one newline-separated string.
+public struct CharacterSnapshot {
+    public static let version: UInt32 = 1
+    static let magic: UInt32 = 0x5343_4D52 // "RMCS"
+    static let headerSize = 32
+    static let recordSize = 4 + Field.allCases.count * 8
+    static let nilLength = UInt32.max
+
+    public enum Error: Swift.Error {
+        case truncated
+        case invalidMagic
+        case unsupportedVersion(UInt32)
+        /// An index entry or a string reference points outside the file.
+        case corrupt
+    }
+
+    /// Strings stored per record, in record order.
+    public enum Field: Int, CaseIterable {
+        case name
+        case status
+        case species
+        case type
+        case gender
+        case originName
+        case originURL
+        case locationName
+        case locationURL
+        case image
+        case episodes
+        case url
+        case created
+    }
+
+    private let data: Data
+    private let indexOffset: Int
+    private let recordsOffset: Int
+    private let arenaOffset: Int
+    private let arenaLength: Int
+
+    public let count: Int
+
+    /// Snapshot backed by `data`, which is only read, never copied.
+    public init(data: Data) throws {
+        guard data.count >= CharacterSnapshot.headerSize else { throw Error.truncated }
+        self.data = data
+
+        let header = (0..<8).map { data.readUInt32(at: $0 * 4) }
+        guard header[0] == CharacterSnapshot.magic else { throw Error.invalidMagic }
+        guard header[1] == CharacterSnapshot.version, Int(header[3]) == CharacterSnapshot.recordSize else {
+            throw Error.unsupportedVersion(header[1])
+        }
+
+        count = Int(header[2])
+        indexOffset = Int(header[4])
+        recordsOffset = Int(header[5])
+        arenaOffset = Int(header[6])
+        arenaLength = Int(header[7])
+        guard indexOffset + count * 8 <= data.count,
+              recordsOffset + count * CharacterSnapshot.recordSize <= data.count,
+              arenaOffset + arenaLength <= data.count else { throw Error.truncated }
+
+        for entry in 0..<count where Int(data.readUInt32(at: indexOffset + entry * 8 + 4)) >= count {
+            throw Error.corrupt
+        }
+        for record in 0..<count {
+            let references = recordsOffset + record * CharacterSnapshot.recordSize + 4
+            for field in 0..<Field.allCases.count {
+                let length = data.readUInt32(at: references + field * 8 + 4)
+                guard length == CharacterSnapshot.nilLength
+                        || Int(data.readUInt32(at: references + field * 8)) + Int(length) <= arenaLength else {
+                    throw Error.corrupt
+                }
+            }
+        }
+    }
+
+    /// Maps the file instead of reading it, so pages are only faulted in for the records used.
+    public init(contentsOf url: URL) throws {
+        try self.init(data: Data(contentsOf: url, options: .alwaysMapped))
+    }
+
+    public var ids: [Int] {
+        return (0..<count).map(id(at:))
+    }
+
+    public func id(at index: Int) -> Int {
+        return Int(data.readUInt32(at: recordOffset(index)))
+    }
+
+    public func string(_ field: Field, at index: Int) -> String? {
+        let reference = recordOffset(index) + 4 + field.rawValue * 8
+        let length = data.readUInt32(at: reference + 4)
+        guard length != CharacterSnapshot.nilLength else { return nil }
+
+        let start = data.startIndex + arenaOffset + Int(data.readUInt32(at: reference))
+        return String(decoding: data[start..<start + Int(length)], as: UTF8.self)
+    }
+
+    public func name(at index: Int) -> String {
+        return string(.name, at: index) ?? ""
+    }
+
+    public func character(at index: Int) -> Character {
+        let string = { (field: Field) in self.string(field, at: index) }
+        let episodes = string(.episodes) ?? ""
+        return Character(id: id(at: index),
+                         name: string(.name) ?? "",
+                         status: string(.status) ?? "",
+                         species: string(.species) ?? "",
+                         type: string(.type) ?? "",
+                         gender: string(.gender) ?? "",
+                         origin: Location(name: string(.originName), url: string(.originURL)),
+                         location: Location(name: string(.locationName), url: string(.locationURL)),
+                         image: string(.image) ?? "",
+                         episode: episodes.isEmpty ? [] : episodes.components(separatedBy: "\n"),
+                         url: string(.url) ?? "",
+                         created: string(.created) ?? "")
+    }
+
+    /// Record number of `id`, by binary search of the index.
+    public func index(ofID id: Int) -> Int? {
+        var low = 0
+        var high = count - 1
+        while low <= high {
+            let middle = (low + high) / 2
+            let entry = indexOffset + middle * 8
+            let candidate = Int(data.readUInt32(at: entry))
+            if candidate == id {
+                return Int(data.readUInt32(at: entry + 4))
+            } else if candidate < id {
+                low = middle + 1
+            } else {
+                high = middle - 1
+            }
+        }
+        return nil
+    }
+
+    public func character(id: Int) -> Character? {
+        return index(ofID: id).map(character(at:))
+    }
+
+    private func recordOffset(_ index: Int) -> Int {
+        precondition(index >= 0 && index < count, "Record \(index) out of bounds")
+        return recordsOffset + index * CharacterSnapshot.recordSize
+    }
+
+    /// Serializes `characters` in the given order; lookups by id go through the index.
+    public static func encode(_ characters: [Character]) -> Data {
+        var builder = Builder(arena: Data())
+        for character in characters {
+            builder.append(character)
+        }
+        return builder.finish()
+    }
+
+    /// Serializes `base` with `characters` added, or replacing its records of the same id, in id order.
+    ///
+    /// Records of `base` that are kept are copied with its arena as they are, without being
+    /// decoded. Strings only used by replaced records stay in the arena; once a quarter of the
+    /// records are replaced, everything is decoded and encoded again to drop them.
+    public static func encode(_ characters: [Character], over base: CharacterSnapshot) -> Data {
+        let replacements = Dictionary(characters.map { ($0.id, $0) }, uniquingKeysWith: { _, last in last })
+        if replacements.count * 4 >= base.count {
+            var merged = replacements
+            for record in 0..<base.count where merged[base.id(at: record)] == nil {
+                merged[base.id(at: record)] = base.character(at: record)
+            }
+            return encode(merged.values.sorted { $0.id < $1.id })
+        }
+
+        let arenaStart = base.data.startIndex + base.arenaOffset
+        var builder = Builder(arena: Data(base.data[arenaStart..<arenaStart + base.arenaLength]))
+        let added = replacements.keys.sorted()
+        var next = 0
+        // Index entries are sorted by id, so both lists are merged in id order.
+        for entry in 0..<base.count {
+            let position = base.indexOffset + entry * 8
+            let id = Int(base.data.readUInt32(at: position))
+            while next < added.count && added[next] < id {
+                builder.append(replacements[added[next]]!)
+                next += 1
+            }
+            if next < added.count && added[next] == id {
+                builder.append(replacements[id]!)
+                next += 1
+            } else {
+                builder.appendRecord(Int(base.data.readUInt32(at: position + 4)), of: base)
+            }
+        }
+        for id in added[next...] {
+            builder.append(replacements[id]!)
+        }
+        return builder.finish()
+    }
+
+    /// Records and arena of a snapshot being written.
+    private struct Builder {
+        var arena: Data
+        var interned = [String: UInt32]()
+        var records = Data()
+        var ids = [Int]()
+
+        mutating func append(_ character: Character) {
+            ids.append(character.id)
+            records.appendUInt32(UInt32(character.id))
+            for field in Field.allCases {
+                switch field {
+                case .name: appendString(character.name)
+                case .status: appendString(character.status)
+                case .species: appendString(character.species)
+                case .type: appendString(character.type)
+                case .gender: appendString(character.gender)
+                case .originName: appendString(character.origin.name)
+                case .originURL: appendString(character.origin.url)
+                case .locationName: appendString(character.location.name)
+                case .locationURL: appendString(character.location.url)
+                case .image: appendString(character.image)
+                case .episodes: appendString(character.episode.joined(separator: "\n"))
+                case .url: appendString(character.url)
+                case .created: appendString(character.created)
+                }
+            }
+        }
+
+        /// Copies `record` of `base` as is: its string references stay valid because `arena`
+        /// starts with `base`'s arena.
+        mutating func appendRecord(_ record: Int, of base: CharacterSnapshot) {
+            let start = base.data.startIndex + base.recordOffset(record)
+            ids.append(base.id(at: record))
+            records.append(base.data[start..<start + CharacterSnapshot.recordSize])
+        }
+
+        private mutating func appendString(_ string: String?) {
+            guard let string = string else {
+                records.appendUInt32(0)
+                records.appendUInt32(CharacterSnapshot.nilLength)
+                return
+            }
+            let offset: UInt32
+            if let existing = interned[string] {
+                offset = existing
+            } else {
+                offset = UInt32(arena.count)
+                interned[string] = offset
+                arena.append(contentsOf: Array(string.utf8))
+            }
+            records.appendUInt32(offset)
+            records.appendUInt32(UInt32(string.utf8.count))
+        }
+
+        func finish() -> Data {
+            var index = Data(capacity: ids.count * 8)
+            for (id, record) in ids.enumerated().map({ ($1, $0) }).sorted(by: { $0.0 < $1.0 }) {
+                index.appendUInt32(UInt32(id))
+                index.appendUInt32(UInt32(record))
+            }
+
+            let indexOffset = CharacterSnapshot.headerSize
+            let recordsOffset = indexOffset + index.count
+            let arenaOffset = recordsOffset + records.count
+
+            var data = Data(capacity: arenaOffset + arena.count)
+            let header = [CharacterSnapshot.magic, CharacterSnapshot.version, UInt32(ids.count), UInt32(CharacterSnapshot.recordSize),
+                          UInt32(indexOffset), UInt32(recordsOffset), UInt32(arenaOffset), UInt32(arena.count)]
+            for value in header {
+                data.appendUInt32(value)
+            }
+            data.append(index)
+            data.append(records)
+            data.append(arena)
+            return data
+        }
+    }
+}
+
+/// Little-endian integers of the binary files (`CharacterSnapshot`, the persisted `FuzzyNameIndex`).
+extension Data {
+    func readUInt32(at offset: Int) -> UInt32 {
+        let start = startIndex + offset
+        return UInt32(self[start])
+            | UInt32(self[start + 1]) << 8
+            | UInt32(self[start + 2]) << 16
+            | UInt32(self[start + 3]) << 24
+    }
+
+    mutating func appendUInt32(_ value: UInt32) {
+        append(contentsOf: [UInt8(truncatingIfNeeded: value),
+                            UInt8(truncatingIfNeeded: value >> 8),
+                            UInt8(truncatingIfNeeded: value >> 16),
+                            UInt8(truncatingIfNeeded: value >> 24)])
+    }
+}
@@ -0,0 +1,310 @@
+//
+//  CharacterStore.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Local, persistent copy of every character the app has seen, plus the page and query
+/// results they came from. Reads never touch the network.
+///
+/// Characters are persisted as a `CharacterSnapshot` next to the JSON file holding the pages and
+/// queries. The snapshot is memory-mapped at launch and records are read from it as they are
+/// asked for; only characters saved since then are held as decoded values.
+///
+/// Characters only ever fetched with a partial projection are kept out of the snapshot, which
+/// holds whole records, until a full fetch; until then `isPartial(id:)` is `true` for them.
+///
+/// The fuzzy search index is persisted with the snapshot and only read back when a search is
+/// about to start, so neither launch nor the first keystroke pays for building it.
+public final class CharacterStore {
+    struct Entry: Codable {
+        var ids: [Int]
+        var fetchedAt: Date
+    }
+    
+    struct Contents: Codable {
+        var characters = [Int: Character]()
+        var pages = [Int: Entry]()
+        var queries = [String: Entry]()
+        var catalogue: CatalogueSyncState?
+        /// Characters never fetched with every field. Optional so older files still decode.
+        var partialIDs: Set<Int>?
+    }
+    
+    private let fileURL: URL?
+    private let queue = DispatchQueue(label: "RickAndMortyCore.CharacterStore")
+    /// Pages, queries and the characters saved since `snapshot` was written (all of them for
+    /// stores written before snapshots existed).
+    private var contents: Contents
+    private let snapshot: CharacterSnapshot?
+    /// Lower-cased name token -> ids of the characters whose name contains it, built on the first search.
+    private var nameIndex = [String: Set<Int>]()
+    private var isNameIndexBuilt = false
+    /// Trigram index of every name, loaded on the first fuzzy search or `prepareFuzzySearch()`.
+    private var fuzzyIndex: FuzzyNameIndex?
+    private var flushScheduled = false
+    /// Something was saved since the files were last written.
+    private var hasChanges = false
+    
+    public init(fileURL: URL? = OfflineSupport.defaultDirectory?.appendingPathComponent("characters.json")) {
+        self.fileURL = fileURL
+        self.contents = fileURL
+            .flatMap { try? Data(contentsOf: $0) }
+            .flatMap { try? JSONDecoder().decode(Contents.self, from: $0) } ?? Contents()
+        self.snapshot = fileURL.flatMap { try? CharacterSnapshot(contentsOf: CharacterStore.snapshotURL(for: $0)) }
+    }
+    
+    static func snapshotURL(for fileURL: URL) -> URL {
+        return fileURL.deletingPathExtension().appendingPathExtension("snapshot")
+    }
+    
+    static func searchIndexURL(for fileURL: URL) -> URL {
+        return fileURL.deletingPathExtension().appendingPathExtension("names")
+    }
+    
+    /// Whether the stored character is missing the fields its partial projections left out.
+    public func isPartial(id: Int) -> Bool {
+        return queue.sync { contents.partialIDs?.contains(id) == true }
+    }
+    
+    public var isEmpty: Bool {
+        return queue.sync { contents.characters.isEmpty && (snapshot?.count ?? 0) == 0 }
+    }
+    
+    public func characters(page: Int) -> [Character]? {
+        return queue.sync { contents.pages[page].map { resolve($0.ids) } }
+    }
+    
+    public func characters(query: String) -> [Character]? {
+        return queue.sync { contents.queries[QueryJournal.normalize(query)].map { resolve($0.ids) } }
+    }
+    
+    /// Characters fetched with a partial `projection` only update those fields of stored ones.
+    public func save(_ characters: [Character], page: Int, projection: CharacterProjection = .all, at date: Date = Date()) {
+        queue.sync {
+            insert(characters, projection: projection)
+            contents.pages[page] = Entry(ids: characters.map(\.id), fetchedAt: date)
+            scheduleFlush()
+        }
+    }
+    
+    public func save(_ characters: [Character], query: String, projection: CharacterProjection = .all, at date: Date = Date()) {
+        queue.sync {
+            insert(characters, projection: projection)
+            contents.queries[QueryJournal.normalize(query)] = Entry(ids: characters.map(\.id), fetchedAt: date)
+            scheduleFlush()
+        }
+    }
+    
+    /// Highest id of the catalogue stored without gaps, 0 when page 1 is missing: pages are
+    /// followed from 1 while each holds all its `pageSize` characters. The delta sync fetches
+    /// every id above it. Characters saved from searches don't count, the ids below them may
+    /// never have been fetched.
+    public func catalogueHighWaterMark(pageSize: Int = 20) -> Int {
+        return queue.sync {
+            var highWaterMark = 0
+            var page = 1
+            while let entry = contents.pages[page] {
+                highWaterMark = max(highWaterMark, entry.ids.max() ?? 0)
+                guard entry.ids.count >= pageSize else { break }
+                page += 1
+            }
+            return highWaterMark
+        }
+    }
+    
+    public var catalogueState: CatalogueSyncState? {
+        return queue.sync { contents.catalogue }
+    }
+    
+    /// Saves characters fetched by id into the pages they belong to. Ids are dense and pages hold
+    /// `pageSize` of them, as the API serves them.
+    public func save(catalogue characters: [Character], state: CatalogueSyncState, pageSize: Int = 20, at date: Date = Date()) {
+        queue.sync {
+            insert(characters)
+            for (page, members) in Dictionary(grouping: characters, by: { ($0.id - 1) / pageSize + 1 }) {
+                let ids = Set(contents.pages[page]?.ids ?? []).union(members.map(\.id))
+                contents.pages[page] = Entry(ids: ids.sorted(), fetchedAt: date)
+            }
+            contents.catalogue = state
+            scheduleFlush()
+        }
+    }
+    
+    /// Local stand-in for the API's `name=` search: every term must start one of the name's words.
+    public func search(name: String) -> [Character] {
+        let terms = CharacterStore.tokens(in: name)
+        guard !terms.isEmpty else { return queue.sync { resolve(contents.pages[1]?.ids ?? []) } }
+        
+        return queue.sync {
+            buildNameIndexIfNeeded()
+            var matches: Set<Int>?
+            for term in terms {
+                var ids = Set<Int>()
+                for (token, tokenIds) in nameIndex where token.hasPrefix(term) {
+                    ids.formUnion(tokenIds)
+                }
+                matches = matches.map { $0.intersection(ids) } ?? ids
+                if matches?.isEmpty == true { break }
+            }
+            return resolve((matches ?? []).sorted())
+        }
+    }
+    
+    /// Typo-tolerant search over every stored name, closest matches first.
+    public func fuzzySearch(name: String, limit: Int = 20) -> [Character] {
+        return queue.sync {
+            let index = loadFuzzyIndexIfNeeded()
+            return resolve(index.search(name, limit: limit).map(\.id))
+        }
+    }
+    
+    /// Loads the search index in the background, e.g. when the search bar gains focus.
+    public func prepareFuzzySearch() {
+        queue.async {
+            _ = self.loadFuzzyIndexIfNeeded()
+        }
+    }
+    
+    /// Pages not refreshed within `age` seconds of `date`.
+    public func stalePages(olderThan age: TimeInterval, at date: Date = Date()) -> [Int] {
+        return queue.sync {
+            contents.pages
+                .filter { date.timeIntervalSince($0.value.fetchedAt) > age }
+                .map(\.key)
+                .sorted()
+        }
+    }
+    
+    public func isFresh(query: String, maximumAge: TimeInterval, at date: Date = Date()) -> Bool {
+        return queue.sync {
+            guard let entry = contents.queries[QueryJournal.normalize(query)] else { return false }
+            return date.timeIntervalSince(entry.fetchedAt) <= maximumAge
+        }
+    }
+    
+    /// Writes pending changes synchronously, e.g. when the app moves to the background.
+    public func flush() {
+        queue.sync(execute: write)
+    }
+    
+    private func resolve(_ ids: [Int]) -> [Character] {
+        return ids.compactMap { contents.characters[$0] ?? snapshot?.character(id: $0) }
+    }
+    
+    private func insert(_ characters: [Character], projection: CharacterProjection = .all) {
+        var partialIDs = contents.partialIDs ?? []
+        defer { contents.partialIDs = partialIDs.isEmpty ? nil : partialIDs }
+        
+        for var character in characters {
+            if projection == .all {
+                partialIDs.remove(character.id)
+            } else if let stored = contents.characters[character.id] ?? snapshot?.character(id: character.id) {
+                character = projection.merge(character, into: stored)
+            } else {
+                partialIDs.insert(character.id)
+            }
+            contents.characters[character.id] = character
+            if isNameIndexBuilt {
+                index(name: character.name, id: character.id)
+            }
+            fuzzyIndex?.insert(id: character.id, name: character.name)
+        }
+    }
+    
+    /// Reads only the names from the snapshot, not whole records.
+    private func buildNameIndexIfNeeded() {
+        guard !isNameIndexBuilt else { return }
+        isNameIndexBuilt = true
+        if let snapshot = snapshot {
+            for record in 0..<snapshot.count {
+                index(name: snapshot.name(at: record), id: snapshot.id(at: record))
+            }
+        }
+        for character in contents.characters.values {
+            index(name: character.name, id: character.id)
+        }
+    }
+    
+    private func loadFuzzyIndexIfNeeded() -> FuzzyNameIndex {
+        if let fuzzyIndex = fuzzyIndex {
+            return fuzzyIndex
+        }
+        let index = loadFuzzyIndex()
+        fuzzyIndex = index
+        return index
+    }
+    
+    /// The persisted index, or one rebuilt from the snapshot's names when it is missing, unreadable
+    /// or older than the snapshot; characters saved since the snapshot are added either way.
+    private func loadFuzzyIndex() -> FuzzyNameIndex {
+        let persisted = fileURL
+            .flatMap { try? Data(contentsOf: CharacterStore.searchIndexURL(for: $0), options: .alwaysMapped) }
+            .flatMap { try? FuzzyNameIndex(data: $0) }
+        
+        let index: FuzzyNameIndex
+        if let persisted = persisted, persisted.count >= snapshot?.count ?? 0 {
+            index = persisted
+        } else {
+            index = FuzzyNameIndex()
+            if let snapshot = snapshot {
+                for record in 0..<snapshot.count where contents.characters[snapshot.id(at: record)] == nil {
+                    index.insert(id: snapshot.id(at: record), name: snapshot.name(at: record))
+                }
+            }
+        }
+        for character in contents.characters.values.sorted(by: { $0.id < $1.id }) {
+            index.insert(id: character.id, name: character.name)
+        }
+        return index
+    }
+    
+    private func index(name: String, id: Int) {
+        for token in CharacterStore.tokens(in: name) {
+            nameIndex[token, default: []].insert(id)
+        }
+    }
+    
+    private func scheduleFlush() {
+        hasChanges = true
+        guard fileURL != nil, !flushScheduled else { return }
+        flushScheduled = true
+        queue.asyncAfter(deadline: .now() + 1, execute: write)
+    }
+    
+    /// Rewrites the snapshot with every whole character, the search index, then the JSON with
+    /// pages, queries and the partial characters, when anything was saved since the last write. The mapped snapshot stays
+    /// valid: the new file replaces it atomically. Its records are copied into the new one without
+    /// being decoded, see `CharacterSnapshot.encode(_:over:)`.
+    ///
+    /// An index not loaded yet is read, updated and written back without being kept in memory.
+    private func write() {
+        flushScheduled = false
+        guard let fileURL = fileURL, hasChanges else { return }
+        hasChanges = false
+        
+        let partialIDs = contents.partialIDs ?? []
+        let characters = contents.characters.values
+            .filter { !partialIDs.contains($0.id) }
+            .sorted { $0.id < $1.id }
+        var index = contents
+        index.characters = contents.characters.filter { partialIDs.contains($0.key) }
+        guard let data = try? JSONEncoder().encode(index) else { return }
+        
+        try? FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+        let snapshotData = snapshot.map { CharacterSnapshot.encode(characters, over: $0) } ?? CharacterSnapshot.encode(characters)
+        guard (try? snapshotData.write(to: CharacterStore.snapshotURL(for: fileURL), options: .atomic)) != nil else { return }
+        let searchIndex = fuzzyIndex ?? loadFuzzyIndex()
+        try? searchIndex.encoded().write(to: CharacterStore.searchIndexURL(for: fileURL), options: .atomic)
+        try? data.write(to: fileURL, options: .atomic)
+    }
+    
+    static func tokens(in text: String) -> [String] {
+        return text.lowercased()
+            .components(separatedBy: CharacterSet.alphanumerics.inverted)
+            .filter { !$0.isEmpty }
+    }
+}
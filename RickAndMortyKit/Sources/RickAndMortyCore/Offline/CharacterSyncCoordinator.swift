@@ -0,0 +1,146 @@
+//
+//  CharacterSyncCoordinator.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Refreshes stale pages and replays journaled searches whenever connectivity comes back.
+///
+/// With a `CatalogueDeltaSync`, stale pages are not refetched one by one: a single delta
+/// refresh brings in new characters and revalidates a few pages instead.
+///
+/// Reachability changes and sync results are received on `scheduler`, the only queue the sync
+/// state is touched on; `sync()` must be called there too.
+public final class CharacterSyncCoordinator {
+    public enum Event {
+        case started(requests: Int)
+        case refreshed(CatalogueRefresh)
+        case finished(requests: Int, failures: Int)
+    }
+    
+    private enum Work: Hashable {
+        case catalogue
+        case page(Int)
+        case query(String)
+    }
+    
+    private let service: CharacterApiServiceProtocol
+    private let deltaSync: CatalogueDeltaSync?
+    private let offline: OfflineSupport
+    private let maximumConcurrentRequests: Int
+    private let scheduler: CoreScheduler
+    private let eventsSubject = PassthroughSubject<Event, Never>()
+    private var bindings = Set<AnyCancellable>()
+    private var currentSync: AnyCancellable?
+    private var isSyncing = false
+    
+    public var events: AnyPublisher<Event, Never> {
+        return eventsSubject.eraseToAnyPublisher()
+    }
+    
+    public init(service: CharacterApiServiceProtocol,
+                deltaSync: CatalogueDeltaSync? = nil,
+                offline: OfflineSupport,
+                maximumConcurrentRequests: Int = 2,
+                scheduler: CoreScheduler = CoreSchedulers.main) {
+        self.service = service
+        self.deltaSync = deltaSync
+        self.offline = offline
+        self.maximumConcurrentRequests = maximumConcurrentRequests
+        self.scheduler = scheduler
+    }
+    
+    public func start() {
+        offline.reachability.reachability
+            .scan((false, false)) { ($0.1, $1) }
+            .filter { wasReachable, isReachable in !wasReachable && isReachable }
+            // `PathReachabilityMonitor` publishes on its own queue.
+            .receive(on: scheduler)
+            .sink { [weak self] _ in self?.sync() }
+            .store(in: &bindings)
+    }
+    
+    /// Runs one sync pass unless one is already in flight.
+    public func sync() {
+        guard !isSyncing, offline.reachability.isReachable else { return }
+        
+        let cutoff = Date()
+        let work = pendingWork(at: cutoff)
+        eventsSubject.send(.started(requests: work.count))
+        guard !work.isEmpty else {
+            offline.journal.markSynced(through: cutoff)
+            eventsSubject.send(.finished(requests: 0, failures: 0))
+            return
+        }
+        
+        let store = offline.store
+        var failures = 0
+        isSyncing = true
+        currentSync = Publishers.Sequence(sequence: work)
+            .flatMap(maxPublishers: .max(maximumConcurrentRequests)) { [service, deltaSync, eventsSubject] item -> AnyPublisher<Void, Never> in
+                let request: AnyPublisher<Void, Error>
+                switch item {
+                case .catalogue:
+                    request = (deltaSync?.refresh() ?? Empty().eraseToAnyPublisher())
+                        .map { eventsSubject.send(.refreshed($0)) }
+                        .eraseToAnyPublisher()
+                case .page(let page):
+                    // The transport, and with it the projection, may change before the response.
+                    let projection = service.projection
+                    request = service.fetchCharacters(page: page)
+                        .map { store.save($0, page: page, projection: projection) }
+                        .eraseToAnyPublisher()
+                case .query(let query):
+                    let projection = service.projection
+                    request = service.searchCharacter(with: query)
+                        .map { store.save($0, query: query, projection: projection) }
+                        .eraseToAnyPublisher()
+                }
+                return request
+                    .catch { _ -> Empty<Void, Never> in
+                        failures += 1
+                        return Empty()
+                    }
+                    .eraseToAnyPublisher()
+            }
+            .collect()
+            .receive(on: scheduler)
+            .sink { [weak self] _ in
+                guard let self = self else { return }
+                if failures == 0 {
+                    self.offline.journal.markSynced(through: cutoff)
+                }
+                self.isSyncing = false
+                self.currentSync = nil
+                self.eventsSubject.send(.finished(requests: work.count, failures: failures))
+            }
+    }
+    
+    /// Stale pages (or one delta refresh standing in for them) plus every journaled search that
+    /// is not already fresh in the store. An empty search is the first page, so both collapse
+    /// into a single request.
+    private func pendingWork(at date: Date) -> [Work] {
+        var work = [Work]()
+        var seen = Set<Work>()
+        
+        let stalePages = offline.store.stalePages(olderThan: offline.maximumAge, at: date)
+        if deltaSync != nil {
+            if !stalePages.isEmpty || offline.store.isEmpty { work.append(.catalogue) }
+        } else {
+            for page in stalePages where seen.insert(.page(page)).inserted {
+                work.append(.page(page))
+            }
+        }
+        for query in offline.journal.pendingQueries() {
+            let item: Work = CharacterRepository.searchName(in: query).isEmpty ? .page(1) : .query(query)
+            if case .query = item, offline.store.isFresh(query: query, maximumAge: offline.maximumAge, at: date) {
+                continue
+            }
+            if seen.insert(item).inserted { work.append(item) }
+        }
+        return work
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  OfflineSupport.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Everything `CharacterRepository` needs to serve reads while the network is unavailable.
+public struct OfflineSupport {
+    public let store: CharacterStore
+    public let journal: QueryJournal
+    public let reachability: ReachabilityMonitoring
+    /// Cached pages and queries older than this are refreshed by the background sync.
+    public let maximumAge: TimeInterval
+    
+    public init(store: CharacterStore = CharacterStore(),
+                journal: QueryJournal = QueryJournal(),
+                reachability: ReachabilityMonitoring,
+                maximumAge: TimeInterval = 60 * 60) {
+        self.store = store
+        self.journal = journal
+        self.reachability = reachability
+        self.maximumAge = maximumAge
+    }
+    
+    public static var defaultDirectory: URL? {
+        return FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first?
+            .appendingPathComponent("RickAndMorty", isDirectory: true)
+    }
+    
+    #if canImport(Network)
+    public static func standard() -> OfflineSupport {
+        return OfflineSupport(reachability: PathReachabilityMonitor())
+    }
+    #endif
+}
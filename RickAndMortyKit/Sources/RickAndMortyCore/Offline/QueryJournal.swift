@@ -0,0 +1,91 @@
+//
+//  QueryJournal.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Persistent log of the searches the user ran, so they can be replayed once the network is back.
+public final class QueryJournal {
+    public struct Entry: Codable {
+        public let query: String
+        public let recordedAt: Date
+        public var syncedAt: Date?
+    }
+    
+    /// Searches recorded closer together than this are treated as one typing burst.
+    static let typingWindow: TimeInterval = 2
+    
+    private let fileURL: URL?
+    private let maximumEntries: Int
+    private let queue = DispatchQueue(label: "RickAndMortyCore.QueryJournal")
+    private var entries: [Entry]
+    
+    public init(fileURL: URL? = OfflineSupport.defaultDirectory?.appendingPathComponent("query-journal.json"),
+                maximumEntries: Int = 200) {
+        self.fileURL = fileURL
+        self.maximumEntries = maximumEntries
+        self.entries = fileURL
+            .flatMap { try? Data(contentsOf: $0) }
+            .flatMap { try? JSONDecoder().decode([Entry].self, from: $0) } ?? []
+    }
+    
+    public func record(_ query: String, at date: Date = Date()) {
+        queue.sync {
+            entries.append(Entry(query: query, recordedAt: date, syncedAt: nil))
+            if entries.count > maximumEntries {
+                entries.removeFirst(entries.count - maximumEntries)
+            }
+            persist()
+        }
+    }
+    
+    /// Unsynced queries, oldest first, with duplicates and intermediate keystrokes coalesced away.
+    ///
+    /// A query that is a prefix of the next one recorded within `typingWindow` was never the
+    /// search the user settled on, so refreshing it would only cost a request.
+    public func pendingQueries() -> [String] {
+        return queue.sync {
+            let pending = entries.filter { $0.syncedAt == nil }
+            var seen = Set<String>()
+            var result = [String]()
+            
+            for (index, entry) in pending.enumerated() {
+                let normalized = QueryJournal.normalize(entry.query)
+                if index + 1 < pending.count {
+                    let next = pending[index + 1]
+                    if next.recordedAt.timeIntervalSince(entry.recordedAt) < QueryJournal.typingWindow,
+                       QueryJournal.normalize(next.query).hasPrefix(normalized) {
+                        continue
+                    }
+                }
+                if seen.insert(normalized).inserted {
+                    result.append(entry.query)
+                }
+            }
+            return result
+        }
+    }
+    
+    /// Marks everything recorded up to `date` as synced, including the coalesced keystrokes.
+    public func markSynced(through date: Date) {
+        queue.sync {
+            for index in entries.indices where entries[index].syncedAt == nil && entries[index].recordedAt <= date {
+                entries[index].syncedAt = Date()
+            }
+            persist()
+        }
+    }
+    
+    private func persist() {
+        guard let fileURL = fileURL, let data = try? JSONEncoder().encode(entries) else { return }
+        try? FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+        try? data.write(to: fileURL, options: .atomic)
+    }
+    
+    static func normalize(_ query: String) -> String {
+        return query.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+    }
+}
@@ -0,0 +1,63 @@
+//
+//  Reachability.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(Network)
+import Network
+#endif
+
+public protocol ReachabilityMonitoring: AnyObject {
+    var isReachable: Bool { get }
+    var reachability: AnyPublisher<Bool, Never> { get }
+}
+
+/// Reachability driven by hand: used on Linux and whenever a benchmark needs to flip connectivity.
+public final class ManualReachability: ReachabilityMonitoring {
+    private let subject: CurrentValueSubject<Bool, Never>
+    
+    public init(isReachable: Bool = true) {
+        subject = CurrentValueSubject(isReachable)
+    }
+    
+    public var isReachable: Bool {
+        return subject.value
+    }
+    
+    public var reachability: AnyPublisher<Bool, Never> {
+        return subject.removeDuplicates().eraseToAnyPublisher()
+    }
+    
+    public func set(reachable: Bool) {
+        subject.send(reachable)
+    }
+}
+
+#if canImport(Network)
+public final class PathReachabilityMonitor: ReachabilityMonitoring {
+    private let monitor = NWPathMonitor()
+    private let subject = CurrentValueSubject<Bool, Never>(true)
+    
+    public init(queue: DispatchQueue = DispatchQueue(label: "RickAndMortyCore.reachability", qos: .utility)) {
+        monitor.pathUpdateHandler = { [weak self] path in
+            self?.subject.send(path.status == .satisfied)
+        }
+        monitor.start(queue: queue)
+    }
+    
+    deinit {
+        monitor.cancel()
+    }
+    
+    public var isReachable: Bool {
+        return subject.value
+    }
+    
+    public var reachability: AnyPublisher<Bool, Never> {
+        return subject.removeDuplicates().eraseToAnyPublisher()
+    }
+}
+#endif
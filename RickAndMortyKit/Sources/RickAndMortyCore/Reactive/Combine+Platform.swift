@@ -0,0 +1,36 @@
+//
+//  Combine+Platform.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+// Apple platforms use Combine; Linux builds fall back to OpenCombine, which mirrors its API.
+// Both are re-exported so clients only ever `import RickAndMortyCore`.
+#if canImport(Combine)
+@_exported import Combine
+
+public typealias CoreScheduler = DispatchQueue
+#else
+@_exported import OpenCombine
+@_exported import OpenCombineDispatch
+@_exported import OpenCombineFoundation
+
+public typealias CoreScheduler = DispatchQueue.OCombine
+#endif
+
+public enum CoreSchedulers {
+    public static var main: CoreScheduler {
+        return queue(.main)
+    }
+
+    public static func queue(_ queue: DispatchQueue) -> CoreScheduler {
+        #if canImport(Combine)
+        return queue
+        #else
+        return queue.ocombine
+        #endif
+    }
+}
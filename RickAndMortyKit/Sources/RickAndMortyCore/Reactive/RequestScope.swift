@@ -0,0 +1,58 @@
+//
+//  RequestScope.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// At most one in-flight request per intent. Starting a request cancels the one it supersedes,
+/// and a request that finishes frees its slot, so repeated loads never accumulate subscriptions
+/// the way storing every sink in a `Set<AnyCancellable>` does.
+///
+/// Not thread-safe: start requests and deliver their completions on one scheduler.
+public final class RequestScope<Intent: Hashable> {
+    private var active = [Intent: (id: Int, cancellable: AnyCancellable)]()
+    private var nextID = 0
+
+    public init() {}
+
+    /// Requests in flight.
+    public var count: Int {
+        return active.count
+    }
+
+    public func isActive(_ intent: Intent) -> Bool {
+        return active[intent] != nil
+    }
+
+    /// Cancels the request running for `intent`, then calls `subscribe` to start the new one.
+    /// `subscribe` must call `finished` once the request completed.
+    public func start(_ intent: Intent, _ subscribe: (_ finished: @escaping () -> Void) -> AnyCancellable) {
+        cancel(intent)
+        nextID += 1
+        let id = nextID
+        var finishedBeforeReturning = false
+        let cancellable = subscribe { [weak self] in
+            if self?.active[intent]?.id == id {
+                self?.active[intent] = nil
+            } else {
+                finishedBeforeReturning = true
+            }
+        }
+        if !finishedBeforeReturning {
+            active[intent] = (id, cancellable)
+        }
+    }
+
+    public func cancel(_ intent: Intent) {
+        active.removeValue(forKey: intent)?.cancellable.cancel()
+    }
+
+    public func cancelAll() {
+        let cancellables = active.values.map { $0.cancellable }
+        active.removeAll()
+        cancellables.forEach { $0.cancel() }
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  NetworkConditions.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+/// How `NetworkHarness` shapes the responses it delivers.
+public struct NetworkConditions: Equatable {
+    /// Seconds before the response starts.
+    public var latency: TimeInterval
+    /// Up to this many seconds are added to or taken from `latency`, uniformly at random.
+    public var jitter: TimeInterval
+    /// Bytes per second the body is delivered at; `nil` delivers it in one piece.
+    public var bandwidth: Int?
+    /// Share of requests, from 0 to 1, that fail with `error` instead of being answered.
+    public var errorRate: Double
+    public var error: URLError.Code
+
+    public init(latency: TimeInterval = 0,
+                jitter: TimeInterval = 0,
+                bandwidth: Int? = nil,
+                errorRate: Double = 0,
+                error: URLError.Code = .networkConnectionLost) {
+        self.latency = latency
+        self.jitter = jitter
+        self.bandwidth = bandwidth
+        self.errorRate = errorRate
+        self.error = error
+    }
+
+    /// No delay, no throttling, no errors: replays measure the client alone.
+    public static let ideal = NetworkConditions()
+    public static let wifi = NetworkConditions(latency: 0.02, jitter: 0.005, bandwidth: 5_000_000)
+    public static let lte = NetworkConditions(latency: 0.05, jitter: 0.02, bandwidth: 1_500_000)
+    public static let slow3G = NetworkConditions(latency: 0.4, jitter: 0.1, bandwidth: 50_000)
+    /// LTE where one request in 20 drops its connection.
+    public static let lossy = NetworkConditions(latency: 0.05, jitter: 0.02, bandwidth: 1_500_000, errorRate: 0.05)
+
+    /// Presets by the name `RM_NETWORK_CONDITIONS` takes.
+    public static let presets: [String: NetworkConditions] = [
+        "ideal": .ideal,
+        "wifi": .wifi,
+        "lte": .lte,
+        "3g": .slow3G,
+        "lossy": .lossy
+    ]
+}
+
+/// SplitMix64: the same seed draws the same latencies and failures on every platform, so a
+/// shaped run can be repeated.
+struct SeededRandomNumberGenerator: RandomNumberGenerator {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        state = seed
+    }
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+        return z ^ (z >> 31)
+    }
+}
@@ -0,0 +1,284 @@
+//
+//  NetworkHarness.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+/// Serves the requests of the sessions it makes from a `ReplayBundle`, or from the network
+/// while recording them, and delivers every response under `conditions`.
+///
+/// It works at the `URLProtocol` level, so the services and image loading run unchanged:
+/// only the `URLSession` they are given differs. One harness is active at a time, the last one
+/// that made a session.
+public final class NetworkHarness {
+    public enum Mode {
+        /// Recorded responses only; a request with no recording gets the API's 404.
+        case replay(ReplayBundle)
+        /// The network, with every response written into the recorder's bundle.
+        case record(ReplayRecorder)
+        /// The network, only shaped by the conditions.
+        case live
+    }
+
+    public struct Statistics: Equatable {
+        public var requests = 0
+        /// Requests failed on purpose, see `NetworkConditions.errorRate`.
+        public var injectedFailures = 0
+        /// Replayed requests no route matched.
+        public var unmatched = 0
+        /// Body bytes delivered.
+        public var bytes = 0
+    }
+
+    /// Instructions for one request, drawn when it starts.
+    struct Plan {
+        let delay: TimeInterval
+        let bandwidth: Int?
+        let failure: URLError.Code?
+    }
+
+    public let mode: Mode
+    private let lock = NSLock()
+    private var _conditions: NetworkConditions
+    private var _statistics = Statistics()
+    private var random: SeededRandomNumberGenerator
+    /// Fetches for `.live` and `.record`; it does not go through the harness itself.
+    let upstream = URLSession(configuration: .ephemeral)
+
+    public init(mode: Mode, conditions: NetworkConditions = .ideal, seed: UInt64 = 1) {
+        self.mode = mode
+        self._conditions = conditions
+        self.random = SeededRandomNumberGenerator(seed: seed)
+    }
+
+    /// Reads the harness to use from `RM_NETWORK_REPLAY` (a bundle directory to replay) or
+    /// `RM_NETWORK_RECORD` (a directory to record into), shaped by `RM_NETWORK_CONDITIONS`
+    /// (a name from `NetworkConditions.presets`) and seeded by `RM_NETWORK_SEED`.
+    /// Returns `nil` when none of them is set.
+    public convenience init?(environment: [String: String]) throws {
+        let conditions = try environment["RM_NETWORK_CONDITIONS"].map { (name) -> NetworkConditions in
+            guard let conditions = NetworkConditions.presets[name.lowercased()] else {
+                throw NetworkHarnessError.unknownConditions(name)
+            }
+            return conditions
+        }
+        let mode: Mode
+        if let path = environment["RM_NETWORK_REPLAY"] {
+            mode = .replay(try ReplayBundle(directory: URL(fileURLWithPath: path)))
+        } else if let path = environment["RM_NETWORK_RECORD"] {
+            mode = .record(try ReplayRecorder(directory: URL(fileURLWithPath: path)))
+        } else if conditions != nil {
+            mode = .live
+        } else {
+            return nil
+        }
+        self.init(mode: mode, conditions: conditions ?? .ideal, seed: environment["RM_NETWORK_SEED"].flatMap(UInt64.init) ?? 1)
+    }
+
+    public var conditions: NetworkConditions {
+        get {
+            lock.lock(); defer { lock.unlock() }
+            return _conditions
+        }
+        set {
+            lock.lock(); defer { lock.unlock() }
+            _conditions = newValue
+        }
+    }
+
+    public var statistics: Statistics {
+        lock.lock(); defer { lock.unlock() }
+        return _statistics
+    }
+
+    public func resetStatistics() {
+        lock.lock(); defer { lock.unlock() }
+        _statistics = Statistics()
+    }
+
+    /// A session whose requests go through this harness, which becomes the active one.
+    public func makeSession(configuration: URLSessionConfiguration = .ephemeral) -> URLSession {
+        configuration.protocolClasses = [HarnessURLProtocol.self] + (configuration.protocolClasses ?? [])
+        HarnessURLProtocol.harness = self
+        return URLSession(configuration: configuration)
+    }
+
+    func plan() -> Plan {
+        lock.lock(); defer { lock.unlock() }
+        let conditions = _conditions
+        _statistics.requests += 1
+        let jitter = conditions.jitter > 0 ? Double.random(in: -conditions.jitter...conditions.jitter, using: &random) : 0
+        let fails = conditions.errorRate > 0 && Double.random(in: 0..<1, using: &random) < conditions.errorRate
+        if fails {
+            _statistics.injectedFailures += 1
+        }
+        return Plan(delay: max(0, conditions.latency + jitter), bandwidth: conditions.bandwidth, failure: fails ? conditions.error : nil)
+    }
+
+    func recordUnmatched() {
+        lock.lock(); defer { lock.unlock() }
+        _statistics.unmatched += 1
+    }
+
+    func recordDelivered(_ bytes: Int) {
+        lock.lock(); defer { lock.unlock() }
+        _statistics.bytes += bytes
+    }
+}
+
+public enum NetworkHarnessError: Error {
+    case unknownConditions(String)
+}
+
+/// Answers the requests of `NetworkHarness` sessions. URL loading creates one per request.
+final class HarnessURLProtocol: URLProtocol {
+    /// Body chunks per second when the bandwidth is limited.
+    static let ticksPerSecond = 50
+
+    private static let lock = NSLock()
+    private static var _harness: NetworkHarness?
+
+    static var harness: NetworkHarness? {
+        get {
+            lock.lock(); defer { lock.unlock() }
+            return _harness
+        }
+        set {
+            lock.lock(); defer { lock.unlock() }
+            _harness = newValue
+        }
+    }
+
+    private let queue = DispatchQueue(label: "RickAndMortyCore.network-harness")
+    private let stateLock = NSLock()
+    private var isStopped = false
+    private var upstreamTask: URLSessionDataTask?
+
+    override class func canInit(with request: URLRequest) -> Bool {
+        return harness != nil
+    }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+        return request
+    }
+
+    override func startLoading() {
+        guard let harness = HarnessURLProtocol.harness else {
+            client?.urlProtocol(self, didFailWithError: URLError(.cannotConnectToHost))
+            return
+        }
+        let plan = harness.plan()
+        // Read once, for matching, recording and the upstream request alike.
+        let request = ReplayBundle.withBodyData(self.request)
+
+        if let failure = plan.failure {
+            queue.asyncAfter(deadline: .now() + plan.delay) { [weak self] in
+                guard let self = self, !self.stopped else { return }
+                self.client?.urlProtocol(self, didFailWithError: URLError(failure))
+            }
+            return
+        }
+
+        switch harness.mode {
+        case .replay(let bundle):
+            let answer = bundle.response(to: request) ?? notFound(for: request, harness: harness)
+            queue.asyncAfter(deadline: .now() + plan.delay) { [weak self] in
+                self?.deliver(answer.response, body: answer.body, bandwidth: plan.bandwidth, harness: harness)
+            }
+        case .record(let recorder):
+            fetch(request, from: harness, plan: plan) { (response, body) in
+                try? recorder.record(request, response: response, body: body)
+            }
+        case .live:
+            fetch(request, from: harness, plan: plan, then: nil)
+        }
+    }
+
+    override func stopLoading() {
+        stateLock.lock()
+        isStopped = true
+        let task = upstreamTask
+        stateLock.unlock()
+        task?.cancel()
+    }
+
+    private var stopped: Bool {
+        stateLock.lock(); defer { stateLock.unlock() }
+        return isStopped
+    }
+
+    /// The real request, delayed by the plan on top of its own latency.
+    private func fetch(_ request: URLRequest,
+                       from harness: NetworkHarness,
+                       plan: NetworkHarness.Plan,
+                       then record: ((HTTPURLResponse, Data) -> Void)?) {
+        let task = harness.upstream.dataTask(with: request) { [weak self] (data, response, error) in
+            guard let self = self else { return }
+            guard let response = response as? HTTPURLResponse, let data = data else {
+                self.queue.asyncAfter(deadline: .now() + plan.delay) {
+                    guard !self.stopped else { return }
+                    self.client?.urlProtocol(self, didFailWithError: error ?? URLError(.badServerResponse))
+                }
+                return
+            }
+            record?(response, data)
+            self.queue.asyncAfter(deadline: .now() + plan.delay) {
+                self.deliver(response, body: data, bandwidth: plan.bandwidth, harness: harness)
+            }
+        }
+        stateLock.lock()
+        upstreamTask = task
+        let stopped = isStopped
+        stateLock.unlock()
+        if !stopped {
+            task.resume()
+        }
+    }
+
+    /// Sends the body in `ticksPerSecond` chunks per second of `bandwidth`, or at once without one.
+    private func deliver(_ response: HTTPURLResponse, body: Data, bandwidth: Int?, harness: NetworkHarness) {
+        guard !stopped else { return }
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        guard let bandwidth = bandwidth, bandwidth > 0, !body.isEmpty else {
+            client?.urlProtocol(self, didLoad: body)
+            harness.recordDelivered(body.count)
+            client?.urlProtocolDidFinishLoading(self)
+            return
+        }
+        let chunkSize = max(1, bandwidth / HarnessURLProtocol.ticksPerSecond)
+        let interval = 1.0 / Double(HarnessURLProtocol.ticksPerSecond)
+
+        func send(from offset: Int) {
+            guard !stopped else { return }
+            let end = min(offset + chunkSize, body.count)
+            client?.urlProtocol(self, didLoad: body.subdata(in: offset..<end))
+            harness.recordDelivered(end - offset)
+            guard end < body.count else {
+                client?.urlProtocolDidFinishLoading(self)
+                return
+            }
+            queue.asyncAfter(deadline: .now() + interval) {
+                send(from: end)
+            }
+        }
+        send(from: 0)
+    }
+
+    /// What the API answers for an unknown path.
+    private func notFound(for request: URLRequest, harness: NetworkHarness) -> (response: HTTPURLResponse, body: Data) {
+        harness.recordUnmatched()
+        let body = Data("{\"error\":\"There is nothing here\"}".utf8)
+        let response = HTTPURLResponse(url: request.url ?? API.baseURL,
+                                       statusCode: 404,
+                                       httpVersion: "HTTP/1.1",
+                                       headerFields: ["Content-Type": "application/json; charset=utf-8",
+                                                      "Content-Length": String(body.count)])!
+        return (response, body)
+    }
+}
@@ -0,0 +1,229 @@
+//
+//  ReplayBundle.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+/// A directory of recorded responses: `manifest.json` maps each request to the file holding
+/// its body. The format is the one of the benchmark fixtures, so a recording from a device can
+/// be checked in next to them and replayed on Linux CI.
+public struct ReplayBundle {
+    public struct Route: Codable, Equatable {
+        public let path: String
+        /// Percent-encoded query, `nil` for none.
+        public let query: String?
+        public let fixture: String
+        /// `GET` when missing.
+        public var method: String?
+        /// Any host when missing, as for the API fixtures recorded against a single server.
+        public var host: String?
+        /// 200 when missing.
+        public var status: Int?
+        /// Guessed from the fixture's extension when missing.
+        public var contentType: String?
+        /// `ReplayBundle.hash(of:)` of the request body, so GraphQL queries posted to the same path
+        /// get their own answers. Any body when missing.
+        public var bodyHash: String?
+
+        public init(path: String, query: String?, fixture: String,
+                    method: String? = nil, host: String? = nil, status: Int? = nil, contentType: String? = nil,
+                    bodyHash: String? = nil) {
+            self.path = path
+            self.query = query
+            self.fixture = fixture
+            self.method = method
+            self.host = host
+            self.status = status
+            self.contentType = contentType
+            self.bodyHash = bodyHash
+        }
+
+        /// `requestBodyHash` is `ReplayBundle.bodyHash(of: request)`, hashed once for every route.
+        func matches(_ request: URLRequest, bodyHash requestBodyHash: String?) -> Bool {
+            guard let url = request.url, let components = URLComponents(url: url, resolvingAgainstBaseURL: false) else {
+                return false
+            }
+            return components.path == path
+                && components.percentEncodedQuery == query
+                && (request.httpMethod ?? "GET") == (method ?? "GET")
+                && (host == nil || components.host == host)
+                && (bodyHash == nil || bodyHash == requestBodyHash)
+        }
+    }
+
+    public struct Manifest: Codable {
+        public var version: Int
+        public var routes: [Route]
+
+        public init(version: Int = 1, routes: [Route] = []) {
+            self.version = version
+            self.routes = routes
+        }
+    }
+
+    public let directory: URL
+    public let manifest: Manifest
+    private let bodies: [String: Data]
+
+    /// Reads the manifest and every fixture it names up front, so replaying never touches the disk.
+    public init(directory: URL) throws {
+        self.directory = directory
+        manifest = try JSONDecoder().decode(Manifest.self, from: Data(contentsOf: directory.appendingPathComponent("manifest.json")))
+        var bodies = [String: Data]()
+        for route in manifest.routes where bodies[route.fixture] == nil {
+            bodies[route.fixture] = try Data(contentsOf: directory.appendingPathComponent(route.fixture))
+        }
+        self.bodies = bodies
+    }
+
+    /// The recorded answer to `request`, or `nil` when none of the routes matches it.
+    /// Bodies are read from `httpBody`; see `withBodyData(_:)` for requests that stream them.
+    public func response(to request: URLRequest) -> (response: HTTPURLResponse, body: Data)? {
+        let bodyHash = ReplayBundle.bodyHash(of: request)
+        guard let url = request.url,
+              let route = manifest.routes.first(where: { $0.matches(request, bodyHash: bodyHash) }),
+              let body = bodies[route.fixture],
+              let response = HTTPURLResponse(url: url,
+                                             statusCode: route.status ?? 200,
+                                             httpVersion: "HTTP/1.1",
+                                             headerFields: ["Content-Type": route.contentType ?? ReplayBundle.contentType(of: route.fixture),
+                                                            "Content-Length": String(body.count)]) else { return nil }
+        return (response, body)
+    }
+
+    /// `request` with a streamed body read into `httpBody`, as URL loading hands requests to
+    /// protocols with their body as a stream. The stream can only be read once.
+    public static func withBodyData(_ request: URLRequest) -> URLRequest {
+        guard request.httpBody == nil, let stream = request.httpBodyStream else { return request }
+        var body = Data()
+        var buffer = [UInt8](repeating: 0, count: 16 * 1024)
+        stream.open()
+        defer { stream.close() }
+        while stream.hasBytesAvailable {
+            let count = stream.read(&buffer, maxLength: buffer.count)
+            guard count > 0 else { break }
+            body.append(buffer, count: count)
+        }
+        var request = request
+        request.httpBody = body
+        return request
+    }
+
+    /// 64-bit FNV-1a of `body` in hex; unlike `hashValue` it is the same in every run and on every platform.
+    public static func hash(of body: Data) -> String {
+        var hash: UInt64 = 0xCBF2_9CE4_8422_2325
+        for byte in body {
+            hash = (hash ^ UInt64(byte)) &* 0x0000_0100_0000_01B3
+        }
+        let hex = String(hash, radix: 16)
+        return String(repeating: "0", count: 16 - hex.count) + hex
+    }
+
+    /// Hash of the body of a request other than `GET`, the only ones routes tell apart by body.
+    static func bodyHash(of request: URLRequest) -> String? {
+        guard (request.httpMethod ?? "GET") != "GET" else { return nil }
+        return hash(of: request.httpBody ?? Data())
+    }
+
+    static func contentType(of fixture: String) -> String {
+        switch (fixture as NSString).pathExtension.lowercased() {
+        case "json": return "application/json; charset=utf-8"
+        case "jpeg", "jpg": return "image/jpeg"
+        case "png": return "image/png"
+        default: return "application/octet-stream"
+        }
+    }
+}
+
+/// Writes responses into a `ReplayBundle` directory as they arrive. Each body is written once
+/// per route, and the manifest after every new route, so a recording interrupted at any point
+/// can still be replayed.
+public final class ReplayRecorder {
+    public let directory: URL
+    private let lock = NSLock()
+    private var manifest: ReplayBundle.Manifest
+
+    /// Keeps the routes of a bundle already in `directory`, so recordings can be extended.
+    public init(directory: URL) throws {
+        self.directory = directory
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        let manifestURL = directory.appendingPathComponent("manifest.json")
+        if FileManager.default.fileExists(atPath: manifestURL.path) {
+            manifest = try JSONDecoder().decode(ReplayBundle.Manifest.self, from: Data(contentsOf: manifestURL))
+        } else {
+            manifest = ReplayBundle.Manifest()
+        }
+    }
+
+    public var routes: [ReplayBundle.Route] {
+        lock.lock(); defer { lock.unlock() }
+        return manifest.routes
+    }
+
+    /// `request`'s body is read from `httpBody`, see `ReplayBundle.withBodyData(_:)`.
+    public func record(_ request: URLRequest, response: HTTPURLResponse, body: Data) throws {
+        guard let url = request.url, let components = URLComponents(url: url, resolvingAgainstBaseURL: false) else { return }
+        let method = request.httpMethod ?? "GET"
+        let contentType = response.value(forHTTPHeaderField: "Content-Type")
+        let bodyHash = ReplayBundle.bodyHash(of: request)
+
+        lock.lock(); defer { lock.unlock() }
+        guard !manifest.routes.contains(where: { $0.matches(request, bodyHash: bodyHash) }) else { return }
+        let fixture = uniqueFixtureName(for: components, method: method, bodyHash: bodyHash, contentType: contentType)
+        try body.write(to: directory.appendingPathComponent(fixture))
+        manifest.routes.append(ReplayBundle.Route(path: components.path,
+                                                  query: components.percentEncodedQuery,
+                                                  fixture: fixture,
+                                                  method: method == "GET" ? nil : method,
+                                                  host: components.host,
+                                                  status: response.statusCode == 200 ? nil : response.statusCode,
+                                                  contentType: contentType,
+                                                  bodyHash: bodyHash))
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        try encoder.encode(manifest).write(to: directory.appendingPathComponent("manifest.json"))
+    }
+
+    /// `/api/character?page=2` becomes `character-page-2.json`, like the checked-in fixtures;
+    /// a GraphQL query `post-graphql-<body hash>.json`.
+    private func uniqueFixtureName(for components: URLComponents, method: String, bodyHash: String?, contentType: String?) -> String {
+        var parts = components.path.split(separator: "/").map(String.init)
+        if parts.first == "api" {
+            parts.removeFirst()
+        }
+        if method != "GET" {
+            parts.insert(method.lowercased(), at: 0)
+        }
+        if let bodyHash = bodyHash {
+            parts.append(String(bodyHash.prefix(8)))
+        }
+        var stem = (parts + [components.query].compactMap { $0 }).joined(separator: "-")
+        let pathExtension = (stem as NSString).pathExtension
+        if !pathExtension.isEmpty {
+            stem = (stem as NSString).deletingPathExtension
+        }
+        let allowed = CharacterSet.alphanumerics.union(CharacterSet(charactersIn: "-_"))
+        stem = String(String.UnicodeScalarView(stem.unicodeScalars.map { allowed.contains($0) ? $0 : "-" }))
+        if stem.isEmpty {
+            stem = "root"
+        }
+        let suffix = !pathExtension.isEmpty ? pathExtension
+            : contentType?.contains("json") == true ? "json"
+            : "bin"
+
+        let taken = Set(manifest.routes.map(\.fixture))
+        var name = "\(stem).\(suffix)"
+        var counter = 2
+        while taken.contains(name) {
+            name = "\(stem)-\(counter).\(suffix)"
+            counter += 1
+        }
+        return name
+    }
+}
@@ -0,0 +1,168 @@
+//
+//  CharacterRepository.swift
+//  RickAndMortyCore
+//
+//  Created by omaestra on 16/6/21.
+//
+
+import Foundation
+
+public enum RepositoryError: Error {
+    case offline
+}
+
+public protocol CharacterRepositoryProtocol {
+    func fetchCharacters() -> AnyPublisher<[Character], Error>
+    func fetchCharacters(page: Int) -> AnyPublisher<[Character], Error>
+    func searchCharacter(with query: String) -> AnyPublisher<[Character], Error>
+    /// Typo-tolerant search by name, answered locally; up to `limit` characters, closest first.
+    func fuzzySearchCharacter(name: String, limit: Int) -> AnyPublisher<[Character], Error>
+    /// Gets the fuzzy search ready ahead of the first keystroke.
+    func prepareFuzzySearch()
+}
+
+public extension CharacterRepositoryProtocol {
+    /// Without a local catalogue, the API's substring search.
+    func fuzzySearchCharacter(name: String, limit: Int) -> AnyPublisher<[Character], Error> {
+        return searchCharacter(with: "name=\(name)")
+    }
+    
+    func prepareFuzzySearch() {}
+}
+
+public final class CharacterRepository {
+    private let apiService: CharacterApiServiceProtocol
+    private let offline: OfflineSupport?
+    private let graph: RelationshipGraph?
+    private let syncCoordinator: CharacterSyncCoordinator?
+    private let deltaSync: CatalogueDeltaSync?
+    
+    /// With `offline` set, reads are answered from the local store first, searches are journaled
+    /// and a background sync refreshes stale data whenever connectivity comes back.
+    /// Every character loaded is added to `graph`.
+    ///
+    /// `deltaSync` switches the background sync from refetching every stale page to a delta
+    /// refresh of the catalogue; it is expected to write into `offline`'s store.
+    public init(service: CharacterApiServiceProtocol = CharacterApiService(),
+                offline: OfflineSupport? = nil,
+                deltaSync: CatalogueDeltaSync? = nil,
+                graph: RelationshipGraph? = nil) {
+        self.apiService = service
+        self.offline = offline
+        self.graph = graph
+        self.deltaSync = offline == nil ? nil : deltaSync
+        self.syncCoordinator = offline.map { CharacterSyncCoordinator(service: service, deltaSync: deltaSync, offline: $0) }
+        syncCoordinator?.start()
+    }
+    
+    /// Runs a delta refresh now, e.g. when the app comes back to the foreground. Fails with
+    /// `RepositoryError.offline` without offline support, a delta sync or connectivity.
+    public func refreshCatalogue() -> AnyPublisher<CatalogueRefresh, Error> {
+        guard let deltaSync = deltaSync, offline?.reachability.isReachable == true else {
+            return Fail(error: RepositoryError.offline).eraseToAnyPublisher()
+        }
+        return deltaSync.refresh()
+    }
+    
+    public var syncEvents: AnyPublisher<CharacterSyncCoordinator.Event, Never> {
+        return syncCoordinator?.events ?? Empty().eraseToAnyPublisher()
+    }
+    
+    /// The `name` value of a `name=...` search query.
+    static func searchName(in query: String) -> String {
+        let items = URLComponents(string: "?" + query)?.queryItems
+        return items?.first(where: { $0.name == "name" })?.value ?? ""
+    }
+}
+
+extension CharacterRepository: CharacterRepositoryProtocol {
+    public func fetchCharacters() -> AnyPublisher<[Character], Error> {
+        return addingToGraph(loadCharacters(page: 1))
+    }
+    
+    public func fetchCharacters(page: Int) -> AnyPublisher<[Character], Error> {
+        return addingToGraph(loadCharacters(page: page))
+    }
+    
+    public func searchCharacter(with query: String) -> AnyPublisher<[Character], Error> {
+        return addingToGraph(loadSearch(with: query))
+    }
+    
+    /// Searches the offline store's names, so typos still match and no request is made.
+    public func fuzzySearchCharacter(name: String, limit: Int) -> AnyPublisher<[Character], Error> {
+        guard let store = offline?.store else {
+            return searchCharacter(with: "name=\(name)")
+        }
+        return addingToGraph(Deferred { Just(store.fuzzySearch(name: name, limit: limit)) }
+            .setFailureType(to: Error.self)
+            .eraseToAnyPublisher())
+    }
+    
+    /// Loads the store's persisted search index in the background.
+    public func prepareFuzzySearch() {
+        offline?.store.prepareFuzzySearch()
+    }
+    
+    private func addingToGraph(_ publisher: AnyPublisher<[Character], Error>) -> AnyPublisher<[Character], Error> {
+        guard let graph = graph else { return publisher }
+        return publisher
+            .handleEvents(receiveOutput: { graph.ingest($0) })
+            .eraseToAnyPublisher()
+    }
+    
+    private func loadCharacters(page: Int) -> AnyPublisher<[Character], Error> {
+        guard let offline = offline else {
+            return remoteCharacters(page: page)
+        }
+        
+        let cached = offline.store.characters(page: page)
+        guard offline.reachability.isReachable else {
+            return cachedOrOffline(cached)
+        }
+        
+        let projection = apiService.projection
+        let remote = remoteCharacters(page: page)
+            .handleEvents(receiveOutput: { offline.store.save($0, page: page, projection: projection) })
+        
+        guard let local = cached, !local.isEmpty else {
+            return remote.eraseToAnyPublisher()
+        }
+        return Just(local)
+            .setFailureType(to: Error.self)
+            .append(remote.catch { _ in Empty<[Character], Error>() })
+            .eraseToAnyPublisher()
+    }
+    
+    /// Page 1 goes through the unpaged endpoint, which is what the list has always requested.
+    private func remoteCharacters(page: Int) -> AnyPublisher<[Character], Error> {
+        return page == 1 ? apiService.fetchCharacters() : apiService.fetchCharacters(page: page)
+    }
+    
+    private func loadSearch(with query: String) -> AnyPublisher<[Character], Error> {
+        guard let offline = offline else {
+            return apiService.searchCharacter(with: query)
+        }
+        
+        offline.journal.record(query)
+        let local = offline.store.characters(query: query)
+            ?? offline.store.search(name: CharacterRepository.searchName(in: query))
+        
+        guard offline.reachability.isReachable else {
+            return Just(local).setFailureType(to: Error.self).eraseToAnyPublisher()
+        }
+        
+        let projection = apiService.projection
+        return apiService.searchCharacter(with: query)
+            .handleEvents(receiveOutput: { offline.store.save($0, query: query, projection: projection) })
+            .catch { _ in Just(local) }
+            .setFailureType(to: Error.self)
+            .eraseToAnyPublisher()
+    }
+    
+    private func cachedOrOffline(_ cached: [Character]?) -> AnyPublisher<[Character], Error> {
+        if let cached = cached {
+            return Just(cached).setFailureType(to: Error.self).eraseToAnyPublisher()
+        }
+        return Fail(error: RepositoryError.offline).eraseToAnyPublisher()
+    }
+}
@@ -0,0 +1,35 @@
+//
+//  EpisodeRepository.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+public protocol EpisodeRepositoryProtocol {
+    func cachedEpisode(id: Int) -> Episode?
+    func fetchEpisodes(ids: [Int]) -> AnyPublisher<[Episode], Error>
+}
+
+public final class EpisodeRepository {
+    private let resources: ResourceRepository<Episode>
+    private let graph: RelationshipGraph?
+    
+    public init(resources: ResourceRepository<Episode> = ResourceRepository(), graph: RelationshipGraph? = nil) {
+        self.resources = resources
+        self.graph = graph
+    }
+}
+
+extension EpisodeRepository: EpisodeRepositoryProtocol {
+    public func cachedEpisode(id: Int) -> Episode? {
+        return resources.cached(id: id)
+    }
+    
+    public func fetchEpisodes(ids: [Int]) -> AnyPublisher<[Episode], Error> {
+        return resources.resources(ids: ids)
+            .handleEvents(receiveOutput: { [graph] in graph?.ingest($0) })
+            .eraseToAnyPublisher()
+    }
+}
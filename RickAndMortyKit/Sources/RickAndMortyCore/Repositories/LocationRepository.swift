@@ -0,0 +1,35 @@
+//
+//  LocationRepository.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+public protocol LocationRepositoryProtocol {
+    func cachedLocation(id: Int) -> Location?
+    func fetchLocations(ids: [Int]) -> AnyPublisher<[Location], Error>
+}
+
+public final class LocationRepository {
+    private let resources: ResourceRepository<Location>
+    private let graph: RelationshipGraph?
+    
+    public init(resources: ResourceRepository<Location> = ResourceRepository(), graph: RelationshipGraph? = nil) {
+        self.resources = resources
+        self.graph = graph
+    }
+}
+
+extension LocationRepository: LocationRepositoryProtocol {
+    public func cachedLocation(id: Int) -> Location? {
+        return resources.cached(id: id)
+    }
+    
+    public func fetchLocations(ids: [Int]) -> AnyPublisher<[Location], Error> {
+        return resources.resources(ids: ids)
+            .handleEvents(receiveOutput: { [graph] in graph?.ingest($0) })
+            .eraseToAnyPublisher()
+    }
+}
@@ -0,0 +1,53 @@
+//
+//  ResourceRepository.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Id-keyed cache in front of `ResourceApiService`: only the ids missing from the cache are
+/// requested, all of them in one batched call.
+public final class ResourceRepository<Resource: RemoteResource> {
+    private let service: ResourceApiService<Resource>
+    public let cache: MemoryCache<Int, Resource>
+    
+    public init(service: ResourceApiService<Resource> = ResourceApiService(),
+                cache: MemoryCache<Int, Resource> = MemoryCache(countLimit: 2_000)) {
+        self.service = service
+        self.cache = cache
+    }
+    
+    public func cached(id: Int) -> Resource? {
+        return cache.value(forKey: id)
+    }
+    
+    /// Resources for `ids`, in the same order, skipping ids the API does not know about.
+    public func resources(ids: [Int]) -> AnyPublisher<[Resource], Error> {
+        var found = [Int: Resource]()
+        var missing = [Int]()
+        for id in ids where found[id] == nil {
+            if let resource = cache.value(forKey: id) {
+                found[id] = resource
+            } else {
+                missing.append(id)
+            }
+        }
+        
+        guard !missing.isEmpty else {
+            return Just(ids.compactMap { found[$0] }).setFailureType(to: Error.self).eraseToAnyPublisher()
+        }
+        
+        return service.fetch(ids: missing)
+            .map { [cache] fetched -> [Resource] in
+                for resource in fetched {
+                    guard let id = resource.resourceID else { continue }
+                    cache.setValue(resource, forKey: id)
+                    found[id] = resource
+                }
+                return ids.compactMap { found[$0] }
+            }
+            .eraseToAnyPublisher()
+    }
+}
@@ -0,0 +1,104 @@
+//
+//  FirstSeenResolver.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Resolves the name of the episode each character was first seen in.
+///
+/// Requests made during the same run loop turn (visible rows, prefetched rows, a freshly
+/// loaded page) are coalesced into a single `/api/episode/<ids>` call, and names are cached,
+/// so a page of rows costs at most one episode request.
+public final class FirstSeenResolver {
+    private let episodes: EpisodeRepositoryProtocol
+    private let graph: RelationshipGraph?
+    private let scheduler: CoreScheduler
+    private let resolvedSubject = PassthroughSubject<Set<Int>, Never>()
+    
+    /// Episode id -> character ids waiting for it.
+    private var pending = [Int: Set<Int>]()
+    /// Episode id -> characters to notify once that in-flight episode is fetched.
+    private var awaiting = [Int: Set<Int>]()
+    private var inFlight = Set<Int>()
+    private var flushScheduled = false
+    private var requests = [Int: AnyCancellable]()
+    
+    public private(set) var requestCount = 0
+    
+    /// Ids of characters whose first-seen name just became available.
+    public var resolved: AnyPublisher<Set<Int>, Never> {
+        return resolvedSubject.eraseToAnyPublisher()
+    }
+    
+    public init(episodes: EpisodeRepositoryProtocol,
+                graph: RelationshipGraph? = nil,
+                scheduler: CoreScheduler = CoreSchedulers.main) {
+        self.episodes = episodes
+        self.graph = graph
+        self.scheduler = scheduler
+    }
+    
+    /// Cached name, or `nil` if it still has to be resolved.
+    public func episodeName(for character: Character) -> String? {
+        return firstEpisodeID(of: character)
+            .flatMap(episodes.cachedEpisode(id:))
+            .map(\.name)
+    }
+    
+    /// Queues the characters' first episodes for the next coalesced request.
+    /// Must be called on the resolver's scheduler.
+    public func resolve(_ characters: [Character]) {
+        for character in characters {
+            guard let episode = firstEpisodeID(of: character),
+                  episodes.cachedEpisode(id: episode) == nil else { continue }
+            pending[episode, default: []].insert(character.id)
+        }
+        guard !pending.isEmpty, !flushScheduled else { return }
+        
+        flushScheduled = true
+        scheduler.schedule { [weak self] in
+            self?.flush()
+        }
+    }
+    
+    private func flush() {
+        flushScheduled = false
+        
+        // Episodes already being fetched only need their characters attached.
+        for (id, characters) in pending {
+            awaiting[id, default: []].formUnion(characters)
+        }
+        let ids = pending.keys.filter { !inFlight.contains($0) }.sorted()
+        pending.removeAll()
+        guard !ids.isEmpty else { return }
+        
+        inFlight.formUnion(ids)
+        requestCount += 1
+        
+        let request = requestCount
+        requests[request] = episodes.fetchEpisodes(ids: ids)
+            .receive(on: scheduler)
+            .sink { [weak self] _ in
+                self?.requests[request] = nil
+                self?.complete(ids)
+            } receiveValue: { _ in }
+    }
+    
+    private func complete(_ ids: [Int]) {
+        inFlight.subtract(ids)
+        var characters = Set<Int>()
+        for id in ids {
+            characters.formUnion(awaiting.removeValue(forKey: id) ?? [])
+        }
+        if !characters.isEmpty {
+            resolvedSubject.send(characters)
+        }
+    }
+    
+    private func firstEpisodeID(of character: Character) -> Int? {
+        return graph?.firstEpisode(ofCharacter: character.id) ?? character.firstEpisodeID
+    }
+}
@@ -0,0 +1,66 @@
+//
+//  ApproximateMatcher.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Edit distance between a pattern and its best-matching substring of a text, with Myers'
+/// bit-parallel algorithm: one 64-bit word holds a whole column of the dynamic-programming
+/// matrix, so each text byte costs a handful of word operations whatever the pattern length.
+///
+/// Patterns longer than 64 bytes are truncated.
+public struct ApproximateMatcher {
+    public static let maxPatternLength = 64
+
+    /// Bytes of the pattern at each position, per byte value.
+    private var masks = [UInt64](repeating: 0, count: 256)
+    private let highBit: UInt64
+    public let patternLength: Int
+
+    public init<C: Collection>(pattern: C) where C.Element == UInt8 {
+        let pattern = pattern.prefix(ApproximateMatcher.maxPatternLength)
+        patternLength = pattern.count
+        highBit = patternLength == 0 ? 0 : 1 << UInt64(patternLength - 1)
+        for (position, byte) in pattern.enumerated() {
+            masks[Int(byte)] |= 1 << UInt64(position)
+        }
+    }
+
+    /// Smallest number of insertions, deletions and substitutions turning the pattern into
+    /// a substring of `text`; the pattern length when nothing in `text` matches.
+    public func distance<C: Collection>(in text: C) -> Int where C.Element == UInt8 {
+        guard patternLength > 0 else { return 0 }
+        var positive = UInt64.max
+        var negative: UInt64 = 0
+        var score = patternLength
+        var best = score
+
+        for byte in text {
+            let equal = masks[Int(byte)]
+            let vertical = equal | negative
+            let horizontal = (((equal & positive) &+ positive) ^ positive) | equal
+            var positiveHorizontal = negative | ~(horizontal | positive)
+            var negativeHorizontal = positive & horizontal
+
+            if positiveHorizontal & highBit != 0 {
+                score += 1
+            } else if negativeHorizontal & highBit != 0 {
+                score -= 1
+            }
+            // No carry into row 0: the match may start anywhere in the text.
+            positiveHorizontal <<= 1
+            negativeHorizontal <<= 1
+            positive = negativeHorizontal | ~(vertical | positiveHorizontal)
+            negative = positiveHorizontal & vertical
+
+            if score < best {
+                best = score
+                if best == 0 { break }
+            }
+        }
+        return best
+    }
+}
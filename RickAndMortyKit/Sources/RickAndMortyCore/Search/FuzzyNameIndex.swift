@@ -0,0 +1,250 @@
+//
+//  FuzzyNameIndex.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+public struct FuzzyMatch: Equatable {
+    public let id: Int
+    /// Edits between the query and the closest part of the name.
+    public let distance: Int
+}
+
+/// Typo-tolerant name search: "mortimer smth" finds "Mortimer Smith" where the API's substring
+/// search finds nothing.
+///
+/// Names are normalized (case and diacritics folded, punctuation dropped) and indexed by their
+/// trigrams. A query allowing `k` edits loses at most `3k` of its trigrams, so only names sharing
+/// the rest are scored, with `ApproximateMatcher`; the best `limit` are kept.
+///
+/// Not thread-safe: callers serialize access, as `CharacterStore` does on its queue.
+public final class FuzzyNameIndex {
+    /// Normalized name of each row.
+    private(set) var names = [[UInt8]]()
+    private(set) var ids = [Int]()
+    /// Trigram -> rows whose name contains it, ascending.
+    private(set) var postings = [UInt32: [Int32]]()
+    private var rowOfID = [Int: Int]()
+
+    public init() {}
+
+    public convenience init<S: Sequence>(entries: S) where S.Element == (id: Int, name: String) {
+        self.init()
+        for entry in entries {
+            insert(id: entry.id, name: entry.name)
+        }
+    }
+
+    public var count: Int {
+        return ids.count
+    }
+
+    /// Adds a name, or replaces the one indexed for `id`.
+    public func insert(id: Int, name: String) {
+        let normalized = FuzzyNameIndex.normalize(name)
+        if let row = rowOfID[id] {
+            guard names[row] != normalized else { return }
+            for gram in FuzzyNameIndex.trigrams(of: names[row]) {
+                postings[gram]?.removeAll { $0 == Int32(row) }
+            }
+            names[row] = normalized
+            addPostings(of: row)
+            return
+        }
+        let row = ids.count
+        ids.append(id)
+        names.append(normalized)
+        rowOfID[id] = row
+        addPostings(of: row)
+    }
+
+    /// Up to `limit` names within the allowed edits of `query`, closest first, then shortest.
+    public func search(_ query: String, limit: Int = 20) -> [FuzzyMatch] {
+        let pattern = Array(FuzzyNameIndex.normalize(query).prefix(ApproximateMatcher.maxPatternLength))
+        guard !pattern.isEmpty, limit > 0 else { return [] }
+
+        let maxErrors = FuzzyNameIndex.maxErrors(forLength: pattern.count)
+        let matcher = ApproximateMatcher(pattern: pattern)
+        var best = [(distance: Int, length: Int, row: Int)]()
+
+        func score(_ row: Int) {
+            let distance = matcher.distance(in: names[row])
+            guard distance <= maxErrors else { return }
+            let candidate = (distance: distance, length: names[row].count, row: row)
+            let position = best.firstIndex { ($0.distance, $0.length, $0.row) > (candidate.distance, candidate.length, candidate.row) } ?? best.count
+            guard position < limit else { return }
+            best.insert(candidate, at: position)
+            if best.count > limit {
+                best.removeLast()
+            }
+        }
+
+        let grams = FuzzyNameIndex.trigrams(of: pattern)
+        let required = grams.count - 3 * maxErrors
+        if required > 0 {
+            var hits = [UInt8](repeating: 0, count: names.count)
+            var touched = [Int]()
+            for gram in grams {
+                for row in postings[gram] ?? [] {
+                    let row = Int(row)
+                    if hits[row] == 0 {
+                        touched.append(row)
+                    }
+                    hits[row] += 1
+                }
+            }
+            for row in touched where Int(hits[row]) >= required {
+                score(row)
+            }
+        } else {
+            // Too short for the trigrams to rule anything out.
+            names.indices.forEach(score)
+        }
+        return best.map { FuzzyMatch(id: ids[$0.row], distance: $0.distance) }
+    }
+
+    /// Edits tolerated for a query of `length` normalized bytes: none below 4, then one per 4, up to 3.
+    public static func maxErrors(forLength length: Int) -> Int {
+        return min(3, length / 4)
+    }
+
+    /// Lower-cased ASCII letters and digits, words separated by single spaces.
+    public static func normalize(_ text: String) -> [UInt8] {
+        let folded = text.folding(options: [.caseInsensitive, .diacriticInsensitive], locale: nil).lowercased()
+        var bytes = [UInt8]()
+        bytes.reserveCapacity(folded.utf8.count)
+        for byte in folded.utf8 {
+            let isAlphanumeric = (byte >= UInt8(ascii: "a") && byte <= UInt8(ascii: "z"))
+                || (byte >= UInt8(ascii: "0") && byte <= UInt8(ascii: "9"))
+            if isAlphanumeric {
+                bytes.append(byte)
+            } else if let last = bytes.last, last != UInt8(ascii: " ") {
+                bytes.append(UInt8(ascii: " "))
+            }
+        }
+        if bytes.last == UInt8(ascii: " ") {
+            bytes.removeLast()
+        }
+        return bytes
+    }
+
+    /// Distinct three-byte windows, packed in the low 24 bits.
+    static func trigrams(of bytes: [UInt8]) -> Set<UInt32> {
+        guard bytes.count >= 3 else { return [] }
+        var grams = Set<UInt32>()
+        for start in 0...(bytes.count - 3) {
+            grams.insert(UInt32(bytes[start]) << 16 | UInt32(bytes[start + 1]) << 8 | UInt32(bytes[start + 2]))
+        }
+        return grams
+    }
+
+    private func addPostings(of row: Int) {
+        let value = Int32(row)
+        for gram in FuzzyNameIndex.trigrams(of: names[row]) {
+            // Only a renamed row goes anywhere but the end.
+            if let rows = postings[gram], let last = rows.last, last > value {
+                postings[gram]?.insert(value, at: rows.firstIndex { $0 > value } ?? rows.count)
+            } else {
+                postings[gram, default: []].append(value)
+            }
+        }
+    }
+}
+
+// MARK: - Persistence
+
+/// An index can be saved next to the catalogue snapshot and read back instead of rebuilt,
+/// skipping the normalization and trigram extraction of every name.
+///
+/// Layout, all integers little-endian `UInt32`:
+///
+///     header    magic, version, count, name bytes, trigram count, posting count
+///     ids       count × id
+///     names     count × end offset of the row's normalized name, then the name bytes
+///     trigrams  trigram count × (trigram, end offset of its postings), ascending
+///     postings  posting count × row
+extension FuzzyNameIndex {
+    public static let version: UInt32 = 1
+    static let magic: UInt32 = 0x4946_4D52 // "RMFI"
+    static let headerSize = 24
+
+    public enum ArchiveError: Error {
+        case truncated
+        case invalidMagic
+        case unsupportedVersion(UInt32)
+    }
+
+    public convenience init(data: Data) throws {
+        self.init()
+        guard data.count >= FuzzyNameIndex.headerSize else { throw ArchiveError.truncated }
+        let header = (0..<6).map { data.readUInt32(at: $0 * 4) }
+        guard header[0] == FuzzyNameIndex.magic else { throw ArchiveError.invalidMagic }
+        guard header[1] == FuzzyNameIndex.version else { throw ArchiveError.unsupportedVersion(header[1]) }
+
+        let count = Int(header[2])
+        let byteCount = Int(header[3])
+        let gramCount = Int(header[4])
+        let postingCount = Int(header[5])
+        let idsOffset = FuzzyNameIndex.headerSize
+        let endsOffset = idsOffset + count * 4
+        let bytesOffset = endsOffset + count * 4
+        let gramsOffset = bytesOffset + byteCount
+        let postingsOffset = gramsOffset + gramCount * 8
+        guard postingsOffset + postingCount * 4 <= data.count else { throw ArchiveError.truncated }
+
+        var start = 0
+        for row in 0..<count {
+            let id = Int(data.readUInt32(at: idsOffset + row * 4))
+            let end = Int(data.readUInt32(at: endsOffset + row * 4))
+            guard start <= end, end <= byteCount else { throw ArchiveError.truncated }
+            let from = data.startIndex + bytesOffset + start
+            ids.append(id)
+            names.append(Array(data[from..<from + end - start]))
+            rowOfID[id] = row
+            start = end
+        }
+
+        start = 0
+        for entry in 0..<gramCount {
+            let gram = data.readUInt32(at: gramsOffset + entry * 8)
+            let end = Int(data.readUInt32(at: gramsOffset + entry * 8 + 4))
+            guard start <= end, end <= postingCount else { throw ArchiveError.truncated }
+            let rows = (start..<end).map { Int32(truncatingIfNeeded: data.readUInt32(at: postingsOffset + $0 * 4)) }
+            guard rows.allSatisfy({ $0 >= 0 && Int($0) < count }) else { throw ArchiveError.truncated }
+            postings[gram] = rows
+            start = end
+        }
+    }
+
+    public func encoded() -> Data {
+        let grams = postings.keys.sorted()
+        let byteCount = names.reduce(0) { $0 + $1.count }
+        let postingCount = grams.reduce(0) { $0 + (postings[$1]?.count ?? 0) }
+
+        var data = Data(capacity: FuzzyNameIndex.headerSize + ids.count * 8 + byteCount + grams.count * 8 + postingCount * 4)
+        for value in [FuzzyNameIndex.magic, FuzzyNameIndex.version, UInt32(ids.count),
+                      UInt32(byteCount), UInt32(grams.count), UInt32(postingCount)] {
+            data.appendUInt32(value)
+        }
+        ids.forEach { data.appendUInt32(UInt32($0)) }
+        var end = 0
+        for name in names {
+            end += name.count
+            data.appendUInt32(UInt32(end))
+        }
+        names.forEach { data.append(contentsOf: $0) }
+        end = 0
+        for gram in grams {
+            end += postings[gram]?.count ?? 0
+            data.appendUInt32(gram)
+            data.appendUInt32(UInt32(end))
+        }
+        for gram in grams {
+            postings[gram]?.forEach { data.appendUInt32(UInt32($0)) }
+        }
+        return data
+    }
+}
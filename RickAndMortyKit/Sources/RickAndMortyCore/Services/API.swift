@@ -0,0 +1,12 @@
+//
+//  API.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+public enum API {
+    public static let baseURL = URL(string: "https://rickandmortyapi.com")!
+}
@@ -0,0 +1,130 @@
+//
+//  CharacterApiService.swift
+//  RickAndMortyCore
+//
+//  Created by omaestra on 16/6/21.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+public enum ServiceError: Error {
+    case url(URLError)
+    case urlRequest
+    case decode
+}
+
+public protocol CharacterApiServiceProtocol {
+    func fetchCharacters() -> AnyPublisher<[Character], Error>
+    func fetchCharacters(page: Int) -> AnyPublisher<[Character], Error>
+    func searchCharacter(with query: String) -> AnyPublisher<[Character], Error>
+    /// Catalogue size, read from `page`; the last page is the smallest response that carries it.
+    func fetchInfo(page: Int) -> AnyPublisher<PageInfo, Error>
+    /// Fields the fetched characters carry; the others are empty and must not replace stored ones.
+    var projection: CharacterProjection { get }
+}
+
+public extension CharacterApiServiceProtocol {
+    /// REST responses are whole characters.
+    var projection: CharacterProjection {
+        return .all
+    }
+}
+
+public final class CharacterApiService: CharacterApiServiceProtocol {
+    private let session: URLSession
+    private let baseURL: URL
+    private let scheduler: CoreScheduler
+    private let tracer: StartupTracer?
+    private let meter: TransferMeter?
+    
+    public init(session: URLSession = .shared,
+                baseURL: URL = API.baseURL,
+                scheduler: CoreScheduler = CoreSchedulers.main,
+                tracer: StartupTracer? = .shared,
+                meter: TransferMeter? = nil) {
+        self.session = session
+        self.baseURL = baseURL
+        self.scheduler = scheduler
+        self.tracer = tracer
+        self.meter = meter
+    }
+    
+    public func fetchCharacters() -> AnyPublisher<[Character], Error> {
+        return characters(with: nil)
+    }
+    
+    public func fetchCharacters(page: Int) -> AnyPublisher<[Character], Error> {
+        return characters(with: "page=\(page)")
+    }
+    
+    public func searchCharacter(with query: String) -> AnyPublisher<[Character], Error> {
+        return characters(with: query)
+    }
+    
+    public func fetchInfo(page: Int) -> AnyPublisher<PageInfo, Error> {
+        return request(with: "page=\(page)") { data in
+            guard let info = try JSONDecoder().decode(CharacterData.self, from: data).info else { throw ServiceError.decode }
+            return info
+        }
+    }
+    
+    private func characters(with query: String?) -> AnyPublisher<[Character], Error> {
+        return request(with: query) { try JSONDecoder().decode(CharacterData.self, from: $0).results }
+    }
+    
+    private func request<Output>(with query: String?, decode: @escaping (Data) throws -> Output) -> AnyPublisher<Output, Error> {
+        var dataTask: URLSessionDataTask?
+        
+        let onSubscription: (Subscription) -> Void = { _ in dataTask?.resume() }
+        let onCancel: () -> Void = { dataTask?.cancel() }
+        
+        return Future<Output, Error> { [weak self] promise in
+            guard let urlRequest = self?.getUrlRequest(with: query) else {
+                promise(.failure(ServiceError.urlRequest))
+                return
+            }
+            
+            let tracer = self?.tracer
+            let meter = self?.meter
+            dataTask = self?.session.dataTask(with: urlRequest, completionHandler: { (data, _, error) in
+                guard let data = data else {
+                    if let error = error {
+                        promise(.failure(error))
+                    }
+                    return
+                }
+                tracer?.mark(.firstNetworkResponse)
+                meter?.record(data)
+                do {
+                    let output = try decode(data)
+                    tracer?.mark(.firstDecode)
+                    promise(.success(output))
+                } catch {
+                    promise(.failure(ServiceError.decode))
+                }
+            })
+            
+        }
+        .handleEvents(receiveSubscription: onSubscription, receiveCancel: onCancel)
+        .receive(on: scheduler)
+        .eraseToAnyPublisher()
+    }
+    
+    private func getUrlRequest(with query: String? = nil) -> URLRequest? {
+        guard var components = URLComponents(url: baseURL, resolvingAgainstBaseURL: false) else { return nil }
+        components.path = "/api/character"
+        components.query = query
+        
+        guard let url = components.url else { return nil }
+        
+        var urlRequest = URLRequest(url: url)
+        urlRequest.httpMethod = "GET"
+        urlRequest.allHTTPHeaderFields = [
+            "Content-Type": "application/json"
+        ]
+        return urlRequest
+    }
+}
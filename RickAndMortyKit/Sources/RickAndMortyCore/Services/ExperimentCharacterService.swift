@@ -0,0 +1,47 @@
+//
+//  ExperimentCharacterService.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Sends each request through `graphQL` or `rest`, as `usesGraphQLTransport` says when the
+/// request is made. The experiment platform may only start after the first fetch, so the
+/// transport cannot be chosen once when the service is created.
+public final class ExperimentCharacterService: CharacterApiServiceProtocol {
+    private let experiments: ExperimentConfigStore
+    private let rest: CharacterApiServiceProtocol
+    private let graphQL: CharacterApiServiceProtocol
+
+    public init(experiments: ExperimentConfigStore, rest: CharacterApiServiceProtocol, graphQL: CharacterApiServiceProtocol) {
+        self.experiments = experiments
+        self.rest = rest
+        self.graphQL = graphQL
+    }
+
+    private var current: CharacterApiServiceProtocol {
+        return experiments.current.usesGraphQLTransport ? graphQL : rest
+    }
+
+    public var projection: CharacterProjection {
+        return current.projection
+    }
+
+    public func fetchCharacters() -> AnyPublisher<[Character], Error> {
+        return current.fetchCharacters()
+    }
+
+    public func fetchCharacters(page: Int) -> AnyPublisher<[Character], Error> {
+        return current.fetchCharacters(page: page)
+    }
+
+    public func searchCharacter(with query: String) -> AnyPublisher<[Character], Error> {
+        return current.searchCharacter(with: query)
+    }
+
+    public func fetchInfo(page: Int) -> AnyPublisher<PageInfo, Error> {
+        return current.fetchInfo(page: page)
+    }
+}
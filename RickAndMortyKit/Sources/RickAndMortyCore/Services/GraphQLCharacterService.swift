@@ -0,0 +1,276 @@
+//
+//  GraphQLCharacterService.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+/// Character fields a screen needs; everything else is left out of the GraphQL selection.
+public struct CharacterProjection: Equatable {
+    public enum Field: CaseIterable {
+        case id
+        case name
+        case status
+        case species
+        case type
+        case gender
+        case originName
+        case originURL
+        case locationName
+        case locationURL
+        case image
+        /// Episode ids only; they are turned back into REST episode urls.
+        case episodeIDs
+        case url
+        case created
+    }
+
+    public let fields: Set<Field>
+
+    /// What a list row shows.
+    public static let list = CharacterProjection([.id, .name, .status, .gender, .image, .locationName])
+    public static let all = CharacterProjection(Set(Field.allCases))
+
+    public init(_ fields: Set<Field>) {
+        self.fields = fields.union([.id])
+    }
+
+    public func adding(_ fields: Field...) -> CharacterProjection {
+        return CharacterProjection(self.fields.union(fields))
+    }
+
+    /// `stored` with this projection's fields taken from `fetched`, so a partial record fetched
+    /// after a whole one does not blank out the fields it left out.
+    public func merge(_ fetched: Character, into stored: Character) -> Character {
+        var merged = stored
+        if fields.contains(.name) { merged.name = fetched.name }
+        if fields.contains(.status) { merged.status = fetched.status }
+        if fields.contains(.species) { merged.species = fetched.species }
+        if fields.contains(.type) { merged.type = fetched.type }
+        if fields.contains(.gender) { merged.gender = fetched.gender }
+        if fields.contains(.originName) { merged.origin.name = fetched.origin.name }
+        if fields.contains(.originURL) { merged.origin.url = fetched.origin.url }
+        if fields.contains(.locationName) { merged.location.name = fetched.location.name }
+        if fields.contains(.locationURL) { merged.location.url = fetched.location.url }
+        if fields.contains(.image) { merged.image = fetched.image }
+        if fields.contains(.episodeIDs) { merged.episode = fetched.episode }
+        if fields.contains(.url) { merged.url = fetched.url }
+        if fields.contains(.created) { merged.created = fetched.created }
+        return merged
+    }
+
+    /// GraphQL selection set for one character, e.g. `id name location { name }`.
+    public var selection: String {
+        func nested(_ name: String, _ subfields: [(Field, String)]) -> String? {
+            let selected = subfields.filter { fields.contains($0.0) }.map { $0.1 }
+            return selected.isEmpty ? nil : "\(name) { \(selected.joined(separator: " ")) }"
+        }
+
+        let parts: [String?] = [
+            "id",
+            fields.contains(.name) ? "name" : nil,
+            fields.contains(.status) ? "status" : nil,
+            fields.contains(.species) ? "species" : nil,
+            fields.contains(.type) ? "type" : nil,
+            fields.contains(.gender) ? "gender" : nil,
+            nested("origin", [(.originName, "name"), (.originURL, "url")]),
+            nested("location", [(.locationName, "name"), (.locationURL, "url")]),
+            fields.contains(.image) ? "image" : nil,
+            fields.contains(.episodeIDs) ? "episode { id }" : nil,
+            fields.contains(.url) ? "url" : nil,
+            fields.contains(.created) ? "created" : nil
+        ]
+        return parts.compactMap { $0 }.joined(separator: " ")
+    }
+}
+
+/// `CharacterApiServiceProtocol` over the API's GraphQL endpoint, requesting only the fields
+/// of `projection`. Fields left out are empty in the returned `Character`s; the offline store
+/// keeps the ones it already has, see `CharacterProjection.merge(_:into:)`.
+///
+/// REST-style queries (`page=2`, `name=rick&status=alive`) are mapped to the `page` and
+/// `filter` arguments, so repositories, the offline store and the sync use it unchanged.
+public final class GraphQLCharacterService: CharacterApiServiceProtocol {
+    static let filterNames: Set<String> = ["name", "status", "species", "type", "gender"]
+
+    private let session: URLSession
+    private let endpoint: URL
+    private let scheduler: CoreScheduler
+    private let tracer: StartupTracer?
+    private let meter: TransferMeter?
+    public let projection: CharacterProjection
+
+    public init(session: URLSession = .shared,
+                baseURL: URL = API.baseURL,
+                projection: CharacterProjection = .list,
+                scheduler: CoreScheduler = CoreSchedulers.main,
+                tracer: StartupTracer? = .shared,
+                meter: TransferMeter? = nil) {
+        self.session = session
+        self.endpoint = baseURL.appendingPathComponent("graphql")
+        self.projection = projection
+        self.scheduler = scheduler
+        self.tracer = tracer
+        self.meter = meter
+    }
+
+    public func fetchCharacters() -> AnyPublisher<[Character], Error> {
+        return characters(with: nil)
+    }
+
+    public func fetchCharacters(page: Int) -> AnyPublisher<[Character], Error> {
+        return characters(with: "page=\(page)")
+    }
+
+    public func searchCharacter(with query: String) -> AnyPublisher<[Character], Error> {
+        return characters(with: query)
+    }
+
+    /// Only `info { count pages }` is selected, whatever the projection.
+    public func fetchInfo(page: Int) -> AnyPublisher<PageInfo, Error> {
+        return request(with: "page=\(page)", selection: "info { count pages }") { data in
+            let response = try JSONDecoder().decode(Response.self, from: data)
+            guard let info = response.data?.characters?.info else { throw ServiceError.decode }
+            return info
+        }
+    }
+
+    private func characters(with query: String?) -> AnyPublisher<[Character], Error> {
+        return request(with: query, selection: "results { \(projection.selection) }", decode: GraphQLCharacterService.decode)
+    }
+
+    private func request<Output>(with query: String?, selection: String, decode: @escaping (Data) throws -> Output) -> AnyPublisher<Output, Error> {
+        var dataTask: URLSessionDataTask?
+
+        let onSubscription: (Subscription) -> Void = { _ in dataTask?.resume() }
+        let onCancel: () -> Void = { dataTask?.cancel() }
+
+        return Future<Output, Error> { [weak self] promise in
+            guard let urlRequest = self?.getUrlRequest(with: query, selection: selection) else {
+                promise(.failure(ServiceError.urlRequest))
+                return
+            }
+
+            let tracer = self?.tracer
+            let meter = self?.meter
+            dataTask = self?.session.dataTask(with: urlRequest, completionHandler: { (data, _, error) in
+                guard let data = data else {
+                    if let error = error {
+                        promise(.failure(error))
+                    }
+                    return
+                }
+                tracer?.mark(.firstNetworkResponse)
+                meter?.record(data)
+                do {
+                    let output = try decode(data)
+                    tracer?.mark(.firstDecode)
+                    promise(.success(output))
+                } catch {
+                    promise(.failure(ServiceError.decode))
+                }
+            })
+        }
+        .handleEvents(receiveSubscription: onSubscription, receiveCancel: onCancel)
+        .receive(on: scheduler)
+        .eraseToAnyPublisher()
+    }
+
+    /// Characters of a `characters { results { ... } }` response. Like the REST endpoint's 404,
+    /// a search without matches (`"characters": null`) is an error.
+    public static func decode(_ data: Data) throws -> [Character] {
+        let response = try JSONDecoder().decode(Response.self, from: data)
+        guard let results = response.data?.characters?.results else { throw ServiceError.decode }
+        return try results.map { try $0.character() }
+    }
+
+    private func getUrlRequest(with query: String?, selection: String) -> URLRequest? {
+        var variables = [String: Any]()
+        var filter = [String: String]()
+        for item in URLComponents(string: "?" + (query ?? ""))?.queryItems ?? [] {
+            guard let value = item.value else { continue }
+            if item.name == "page", let page = Int(value) {
+                variables["page"] = page
+            } else if GraphQLCharacterService.filterNames.contains(item.name) {
+                filter[item.name] = value
+            }
+        }
+        if !filter.isEmpty {
+            variables["filter"] = filter
+        }
+
+        let document = "query Characters($page: Int, $filter: FilterCharacter) { "
+            + "characters(page: $page, filter: $filter) { \(selection) } }"
+        guard let body = try? JSONSerialization.data(withJSONObject: ["query": document, "variables": variables]) else { return nil }
+
+        var urlRequest = URLRequest(url: endpoint)
+        urlRequest.httpMethod = "POST"
+        urlRequest.httpBody = body
+        urlRequest.allHTTPHeaderFields = [
+            "Content-Type": "application/json"
+        ]
+        return urlRequest
+    }
+}
+
+private extension GraphQLCharacterService {
+    struct Response: Decodable {
+        struct Payload: Decodable {
+            let characters: Page?
+        }
+
+        struct Page: Decodable {
+            let info: PageInfo?
+            let results: [ProjectedCharacter]?
+        }
+
+        let data: Payload?
+    }
+
+    struct ProjectedLocation: Decodable {
+        let name: String?
+        let url: String?
+    }
+
+    struct ProjectedEpisode: Decodable {
+        let id: String
+    }
+
+    /// GraphQL ids are strings; every field but `id` may be missing from the projection.
+    struct ProjectedCharacter: Decodable {
+        let id: String
+        let name: String?
+        let status: String?
+        let species: String?
+        let type: String?
+        let gender: String?
+        let origin: ProjectedLocation?
+        let location: ProjectedLocation?
+        let image: String?
+        let episode: [ProjectedEpisode]?
+        let url: String?
+        let created: String?
+
+        func character() throws -> Character {
+            guard let id = Int(id) else { throw ServiceError.decode }
+            let episodes = API.baseURL.appendingPathComponent("api/episode").absoluteString
+            return Character(id: id,
+                             name: name ?? "",
+                             status: status ?? "",
+                             species: species ?? "",
+                             type: type ?? "",
+                             gender: gender ?? "",
+                             origin: Location(name: origin?.name, url: origin?.url),
+                             location: Location(name: location?.name, url: location?.url),
+                             image: image ?? "",
+                             episode: (episode ?? []).map { "\(episodes)/\($0.id)" },
+                             url: url ?? "",
+                             created: created ?? "")
+        }
+    }
+}
@@ -0,0 +1,107 @@
+//
+//  ResourceApiService.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+/// Fetches resources by id through the multi-id endpoint, `maximumBatchSize` ids per request.
+public final class ResourceApiService<Resource: RemoteResource> {
+    private let session: URLSession
+    private let baseURL: URL
+    private let scheduler: CoreScheduler
+    private let maximumBatchSize: Int
+    private let meter: TransferMeter?
+    
+    public init(session: URLSession = .shared,
+                baseURL: URL = API.baseURL,
+                scheduler: CoreScheduler = CoreSchedulers.main,
+                maximumBatchSize: Int = 100,
+                meter: TransferMeter? = nil) {
+        self.session = session
+        self.baseURL = baseURL
+        self.scheduler = scheduler
+        self.maximumBatchSize = maximumBatchSize
+        self.meter = meter
+    }
+    
+    public func fetch(ids: [Int]) -> AnyPublisher<[Resource], Error> {
+        var seen = Set<Int>()
+        let unique = ids.filter { seen.insert($0).inserted }
+        guard !unique.isEmpty else {
+            return Just([]).setFailureType(to: Error.self).eraseToAnyPublisher()
+        }
+        
+        let batches = stride(from: 0, to: unique.count, by: maximumBatchSize).map {
+            Array(unique[$0..<min($0 + maximumBatchSize, unique.count)])
+        }
+        if batches.count == 1 {
+            return request(batches[0])
+        }
+        return Publishers.MergeMany(batches.map(request))
+            .collect()
+            .map { $0.flatMap { $0 } }
+            .eraseToAnyPublisher()
+    }
+    
+    private func request(_ ids: [Int]) -> AnyPublisher<[Resource], Error> {
+        var dataTask: URLSessionDataTask?
+        
+        let onSubscription: (Subscription) -> Void = { _ in dataTask?.resume() }
+        let onCancel: () -> Void = { dataTask?.cancel() }
+        
+        return Future<[Resource], Error> { [weak self] promise in
+            guard let urlRequest = self?.getUrlRequest(for: ids) else {
+                promise(.failure(ServiceError.urlRequest))
+                return
+            }
+            
+            let meter = self?.meter
+            dataTask = self?.session.dataTask(with: urlRequest, completionHandler: { (data, _, error) in
+                guard let data = data else {
+                    if let error = error {
+                        promise(.failure(error))
+                    }
+                    return
+                }
+                meter?.record(data)
+                do {
+                    promise(.success(try ResourceApiService.decode(data)))
+                } catch {
+                    promise(.failure(ServiceError.decode))
+                }
+            })
+        }
+        .handleEvents(receiveSubscription: onSubscription, receiveCancel: onCancel)
+        .receive(on: scheduler)
+        .eraseToAnyPublisher()
+    }
+    
+    /// A single id comes back as a bare object, several as an array.
+    static func decode(_ data: Data) throws -> [Resource] {
+        let decoder = JSONDecoder()
+        if let resources = try? decoder.decode([Resource].self, from: data) {
+            return resources
+        }
+        return [try decoder.decode(Resource.self, from: data)]
+    }
+    
+    private func getUrlRequest(for ids: [Int]) -> URLRequest? {
+        guard var components = URLComponents(url: baseURL, resolvingAgainstBaseURL: false) else { return nil }
+        components.path = "/api/\(Resource.endpoint)/" + ids.map(String.init).joined(separator: ",")
+        
+        guard let url = components.url else { return nil }
+        
+        var urlRequest = URLRequest(url: url)
+        urlRequest.httpMethod = "GET"
+        urlRequest.allHTTPHeaderFields = [
+            "Content-Type": "application/json"
+        ]
+        return urlRequest
+    }
+}
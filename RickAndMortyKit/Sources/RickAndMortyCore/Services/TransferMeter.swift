@@ -0,0 +1,38 @@
+//
+//  TransferMeter.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Counts responses and response body bytes received by the services sharing it.
+public final class TransferMeter {
+    public struct Reading {
+        public let requests: Int
+        public let bytes: Int
+        
+        /// Traffic between `earlier` and this reading.
+        public func since(_ earlier: Reading) -> Reading {
+            return Reading(requests: requests - earlier.requests, bytes: bytes - earlier.bytes)
+        }
+    }
+    
+    private let lock = NSLock()
+    private var requests = 0
+    private var bytes = 0
+    
+    public init() {}
+    
+    public var reading: Reading {
+        lock.lock(); defer { lock.unlock() }
+        return Reading(requests: requests, bytes: bytes)
+    }
+    
+    public func record(_ data: Data) {
+        lock.lock(); defer { lock.unlock() }
+        requests += 1
+        bytes += data.count
+    }
+}
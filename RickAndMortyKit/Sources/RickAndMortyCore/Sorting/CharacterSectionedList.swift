@@ -0,0 +1,91 @@
+//
+//  CharacterSectionedList.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Characters in the order the list shows them, as sections of positions into `characters`.
+public struct CharacterSectionedList {
+    public let characters: [Character]
+    public let sections: [CharacterSection]
+
+    public static let empty = CharacterSectionedList(characters: [], sections: [])
+
+    public init(characters: [Character], sections: [CharacterSection]) {
+        self.characters = characters
+        self.sections = sections
+    }
+
+    public func character(at section: Int, row: Int) -> Character {
+        return characters[sections[section].row(at: row)]
+    }
+
+    /// Sections and rows to delete (at their old positions) and insert (at their new ones) to
+    /// turn `old` into this list, matching sections by title and rows by character id.
+    /// A character moving to another section is deleted from one and inserted in the other.
+    /// Rows that stay put but whose character changed (a refreshed status, a new image...) are
+    /// reloaded, at their old positions.
+    public func difference(from old: CharacterSectionedList) -> SectionedDifference {
+        var difference = SectionedDifference()
+        let oldTitles = old.sections.map { $0.title ?? "" }
+        let newTitles = sections.map { $0.title ?? "" }
+        let oldPositions = Dictionary(oldTitles.enumerated().map { ($1, $0) }, uniquingKeysWith: { first, _ in first })
+
+        for (index, title) in oldTitles.enumerated() where !newTitles.contains(title) {
+            difference.deletedSections.insert(index)
+        }
+        for (newIndex, title) in newTitles.enumerated() {
+            guard let oldIndex = oldPositions[title] else {
+                difference.insertedSections.insert(newIndex)
+                continue
+            }
+            let oldRows = old.sections[oldIndex].rows
+            let newRows = sections[newIndex].rows
+            let oldIDs = oldRows.map { old.characters[Int($0)].id }
+            let newIDs = newRows.map { characters[Int($0)].id }
+            var removed = IndexSet()
+            var inserted = IndexSet()
+            for change in newIDs.difference(from: oldIDs) {
+                switch change {
+                case .remove(let offset, _, _):
+                    removed.insert(offset)
+                    difference.deletedRows.append(SectionedDifference.Position(section: oldIndex, row: offset))
+                case .insert(let offset, _, _):
+                    inserted.insert(offset)
+                    difference.insertedRows.append(SectionedDifference.Position(section: newIndex, row: offset))
+                }
+            }
+            // The rows left untouched are the same characters, in the same order on both sides.
+            let kept = zip(oldRows.indices.filter { !removed.contains($0) }, newRows.indices.filter { !inserted.contains($0) })
+            for (oldRow, newRow) in kept where old.characters[Int(oldRows[oldRow])] != characters[Int(newRows[newRow])] {
+                difference.reloadedRows.append(SectionedDifference.Position(section: oldIndex, row: oldRow))
+            }
+        }
+        return difference
+    }
+}
+
+/// Changes between two `CharacterSectionedList`s, in the shape of a table view batch update.
+public struct SectionedDifference {
+    public struct Position: Equatable {
+        public let section: Int
+        public let row: Int
+    }
+
+    public var deletedSections = IndexSet()
+    public var insertedSections = IndexSet()
+    public var deletedRows = [Position]()
+    public var insertedRows = [Position]()
+    public var reloadedRows = [Position]()
+
+    public var changeCount: Int {
+        return deletedSections.count + insertedSections.count + deletedRows.count + insertedRows.count + reloadedRows.count
+    }
+
+    public var isEmpty: Bool {
+        return changeCount == 0
+    }
+}
@@ -0,0 +1,203 @@
+//
+//  CharacterSortIndex.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+public enum CharacterSortOrder: String, CaseIterable {
+    /// The order the characters were loaded in: the API's, or relevance for a fuzzy search.
+    case original
+    case name
+    /// Alive, then dead, then unknown.
+    case status
+    /// Most episodes first.
+    case episodeCount
+    /// Earliest first episode first.
+    case firstAppearance
+}
+
+public enum CharacterGrouping: String, CaseIterable {
+    case none
+    case species
+    case location
+
+    /// Section a character belongs to, `nil` without grouping.
+    public func title(for character: Character) -> String? {
+        switch self {
+        case .none: return nil
+        case .species: return character.species
+        case .location: return character.location.name ?? "unknown"
+        }
+    }
+}
+
+public struct CharacterListLayout: Equatable {
+    public var order: CharacterSortOrder
+    public var grouping: CharacterGrouping
+
+    public static let `default` = CharacterListLayout(order: .original, grouping: .none)
+
+    public init(order: CharacterSortOrder, grouping: CharacterGrouping) {
+        self.order = order
+        self.grouping = grouping
+    }
+}
+
+public struct CharacterSection: Equatable {
+    /// `nil` for the only section of an ungrouped list.
+    public let title: String?
+    /// Positions in the list's `characters`, in display order.
+    public let rows: [UInt32]
+
+    public func row(at index: Int) -> Int {
+        return Int(rows[index])
+    }
+}
+
+/// Every sort order of a list of characters, kept as a permutation of row numbers.
+///
+/// Sort keys are extracted once per character. When a list grows by a page, the page alone is
+/// sorted and merged into each permutation; switching order or grouping then only walks one
+/// permutation, without comparing or decoding anything.
+///
+/// Not thread-safe: callers serialize access, as `CharacterViewModel` does on its index queue.
+public final class CharacterSortIndex {
+    struct Keys {
+        let id: Int
+        let name: String
+        let statusRank: Int
+        let episodeCount: Int
+        let firstEpisode: Int
+
+        init(_ character: Character) {
+            id = character.id
+            name = character.name.lowercased()
+            switch character.status.lowercased() {
+            case "alive": statusRank = 0
+            case "dead": statusRank = 1
+            default: statusRank = 2
+            }
+            episodeCount = character.episode.count
+            firstEpisode = character.firstEpisodeID ?? Int.max
+        }
+    }
+
+    public private(set) var characters = [Character]()
+    private var keys = [Keys]()
+    private var permutations = [CharacterSortOrder: [UInt32]]()
+
+    public init(characters: [Character] = []) {
+        update(with: characters)
+    }
+
+    public var count: Int {
+        return characters.count
+    }
+
+    /// Takes `characters` as the new list. When it extends the current one (a page arrived) with
+    /// no sort key changed, only the new characters are sorted and merged in; otherwise every
+    /// permutation is rebuilt.
+    ///
+    /// - Returns: whether the update was incremental.
+    @discardableResult
+    public func update(with characters: [Character]) -> Bool {
+        let extends = characters.count >= self.characters.count
+            && zip(self.characters, characters).allSatisfy(CharacterSortIndex.hasSameKeys)
+        if !extends {
+            self.characters = []
+            keys = []
+            permutations = [:]
+        }
+        append(characters[self.characters.count...])
+        // Same keys, possibly other fields (a refreshed image...): keep the newest values.
+        self.characters = characters
+        return extends
+    }
+
+    /// Rows in `order`.
+    public func rows(sortedBy order: CharacterSortOrder) -> [UInt32] {
+        return permutations[order] ?? Array(0..<UInt32(characters.count))
+    }
+
+    /// Rows in `layout`'s order, split in sections named after `layout`'s grouping. Sections are
+    /// sorted by title; rows keep the sort order within each of them.
+    public func sections(for layout: CharacterListLayout) -> [CharacterSection] {
+        let rows = self.rows(sortedBy: layout.order)
+        guard !rows.isEmpty else { return [] }
+        guard layout.grouping != .none else { return [CharacterSection(title: nil, rows: rows)] }
+
+        var groups = [String: [UInt32]]()
+        for row in rows {
+            groups[layout.grouping.title(for: characters[Int(row)]) ?? "", default: []].append(row)
+        }
+        return groups.keys.sorted().map { CharacterSection(title: $0, rows: groups[$0] ?? []) }
+    }
+
+    private func append(_ added: ArraySlice<Character>) {
+        guard !added.isEmpty else { return }
+        let start = characters.count
+        characters.append(contentsOf: added)
+        keys.append(contentsOf: added.map(Keys.init))
+
+        let newRows = Array(UInt32(start)..<UInt32(characters.count))
+        for order in CharacterSortOrder.allCases where order != .original {
+            let precedes = comparator(for: order)
+            let sorted = newRows.sorted(by: precedes)
+            permutations[order] = CharacterSortIndex.merge(permutations[order] ?? [], sorted, by: precedes)
+        }
+    }
+
+    /// Ties are broken by name, then id, so every order is total and stable across updates.
+    private func comparator(for order: CharacterSortOrder) -> (UInt32, UInt32) -> Bool {
+        let keys = self.keys
+        switch order {
+        case .original:
+            return { $0 < $1 }
+        case .name:
+            return { keys[Int($0)].name != keys[Int($1)].name
+                ? keys[Int($0)].name < keys[Int($1)].name
+                : keys[Int($0)].id < keys[Int($1)].id }
+        case .status:
+            return { (keys[Int($0)].statusRank, keys[Int($0)].name, keys[Int($0)].id)
+                < (keys[Int($1)].statusRank, keys[Int($1)].name, keys[Int($1)].id) }
+        case .episodeCount:
+            return { (-keys[Int($0)].episodeCount, keys[Int($0)].name, keys[Int($0)].id)
+                < (-keys[Int($1)].episodeCount, keys[Int($1)].name, keys[Int($1)].id) }
+        case .firstAppearance:
+            return { (keys[Int($0)].firstEpisode, keys[Int($0)].name, keys[Int($0)].id)
+                < (keys[Int($1)].firstEpisode, keys[Int($1)].name, keys[Int($1)].id) }
+        }
+    }
+
+    static func merge(_ lhs: [UInt32], _ rhs: [UInt32], by precedes: (UInt32, UInt32) -> Bool) -> [UInt32] {
+        var merged = [UInt32]()
+        merged.reserveCapacity(lhs.count + rhs.count)
+        var i = 0
+        var j = 0
+        while i < lhs.count && j < rhs.count {
+            if precedes(rhs[j], lhs[i]) {
+                merged.append(rhs[j])
+                j += 1
+            } else {
+                merged.append(lhs[i])
+                i += 1
+            }
+        }
+        merged.append(contentsOf: lhs[i...])
+        merged.append(contentsOf: rhs[j...])
+        return merged
+    }
+
+    static func hasSameKeys(_ lhs: Character, _ rhs: Character) -> Bool {
+        return lhs.id == rhs.id
+            && lhs.name == rhs.name
+            && lhs.status == rhs.status
+            && lhs.species == rhs.species
+            && lhs.location.name == rhs.location.name
+            && lhs.episode.count == rhs.episode.count
+            && lhs.firstEpisodeID == rhs.firstEpisodeID
+    }
+}
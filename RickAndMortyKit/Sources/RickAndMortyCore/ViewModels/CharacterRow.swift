@@ -0,0 +1,104 @@
+//
+//  CharacterRow.swift
+//  RickAndMortyCore
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+
+/// Everything a list row shows for a character, formatted once instead of on every display.
+public struct CharacterRow {
+    public enum Status {
+        case alive
+        case dead
+        case unknown
+    }
+    
+    public let character: Character
+    public let name: String
+    public let statusText: String
+    public let status: Status
+    public let locationName: String?
+    public let imageURL: URL?
+    
+    public init(character: Character) {
+        self.character = character
+        self.name = character.name
+        self.statusText = "\(character.status) - \(character.gender)"
+        switch character.status.lowercased() {
+        case "alive": self.status = .alive
+        case "dead": self.status = .dead
+        default: self.status = .unknown
+        }
+        self.locationName = character.location.name
+        self.imageURL = URL(string: character.image)
+    }
+    
+    public var id: Int {
+        return character.id
+    }
+    
+    static func displaysSameContent(_ lhs: Character, _ rhs: Character) -> Bool {
+        return lhs.name == rhs.name
+            && lhs.status == rhs.status
+            && lhs.gender == rhs.gender
+            && lhs.location.name == rhs.location.name
+            && lhs.image == rhs.image
+    }
+}
+
+/// Turns each list of characters into display models on a background queue and delivers them
+/// on `scheduler`, so the data source only indexes into ready-made rows.
+///
+/// Models are cached by character id: a search returning characters already on screen, or a
+/// page refreshed from the network, reuses them unless a displayed field changed.
+public final class RowModelBuilder<Row> {
+    private let make: (CharacterRow) -> Row
+    private let queue: DispatchQueue
+    private let scheduler: CoreScheduler
+    public let cache = MemoryCache<Int, (character: Character, row: Row)>(countLimit: 2000)
+    
+    public init(queue: DispatchQueue = DispatchQueue(label: "RickAndMortyCore.row-models", qos: .userInitiated),
+                scheduler: CoreScheduler = CoreSchedulers.main,
+                make: @escaping (CharacterRow) -> Row) {
+        self.make = make
+        self.queue = queue
+        self.scheduler = scheduler
+    }
+    
+    public func rows<P: Publisher>(for characters: P) -> AnyPublisher<[Row], Never> where P.Output == [Character], P.Failure == Never {
+        return characters
+            .receive(on: CoreSchedulers.queue(queue))
+            .map { [weak self] characters in self?.rows(for: characters) ?? [] }
+            .receive(on: scheduler)
+            .eraseToAnyPublisher()
+    }
+    
+    /// Rows for values carrying a list of characters, such as a `CharacterSectionedList`; each
+    /// value is delivered along with its rows.
+    public func rows<P: Publisher>(for values: P, characters: @escaping (P.Output) -> [Character]) -> AnyPublisher<(P.Output, [Row]), Never> where P.Failure == Never {
+        return values
+            .receive(on: CoreSchedulers.queue(queue))
+            .map { [weak self] value in (value, self?.rows(for: characters(value)) ?? []) }
+            .receive(on: scheduler)
+            .eraseToAnyPublisher()
+    }
+    
+    /// Synchronous variant, for callers already off the main thread.
+    public func rows(for characters: [Character]) -> [Row] {
+        return characters.map { character in
+            if let cached = cache.value(forKey: character.id), CharacterRow.displaysSameContent(cached.character, character) {
+                return cached.row
+            }
+            let row = make(CharacterRow(character: character))
+            cache.setValue((character, row), forKey: character.id)
+            return row
+        }
+    }
+    
+    /// Drops cached models, e.g. when the list width or the content size category changed.
+    public func invalidate() {
+        cache.removeAll()
+    }
+}
@@ -0,0 +1,218 @@
+//
+//  CharacterViewModel.swift
+//  RickAndMortyCore
+//
+//  Created by omaestra on 16/6/21.
+//
+
+import Foundation
+
+public enum ListViewModelState {
+    case loading
+    case finished
+    /// No connectivity: whatever is shown comes from the local store.
+    case offline
+    case error(Error)
+}
+
+public final class CharacterViewModel: ObservableObject {
+    /// What a request is for; a new request replaces the one in flight for the same intent.
+    public enum Intent: Hashable {
+        case load
+    }
+    
+    public private(set) var characters = CurrentValueSubject<[Character], Never>([])
+    public private(set) var searchText = CurrentValueSubject<String, Never>("")
+    public private(set) var state = CurrentValueSubject<ListViewModelState, Never>(.loading)
+    /// Status, species and gender selections applied to `characters` by `visibleCharacters`.
+    public private(set) var filter = CurrentValueSubject<CharacterFilter, Never>(.none)
+    /// Facet bitmaps of `characters`, rebuilt off the main thread whenever they change.
+    public private(set) var facetIndex = CurrentValueSubject<CharacterFacetIndex, Never>(CharacterFacetIndex(characters: []))
+    /// Sort order and grouping of `sectionedCharacters`.
+    public private(set) var layout = CurrentValueSubject<CharacterListLayout, Never>(.default)
+    
+    /// Long-lived bindings, set up once in `init`.
+    private var bindings = Set<AnyCancellable>()
+    private let requests = RequestScope<Intent>()
+    /// Live `fetch` and `search` request subscriptions, for stress runs to assert on.
+    public let subscriptions = SubscriptionLedger()
+    
+    private let repository: CharacterRepositoryProtocol
+    private let reachability: ReachabilityMonitoring?
+    private let analytics: Analytics?
+    private let scheduler: CoreScheduler
+    private let indexQueue = DispatchQueue(label: "RickAndMortyCore.facet-index", qos: .userInitiated)
+    
+    /// Rows loaded by `fetchCharacters()`, as consecutive API pages of 20.
+    public var pageSize = 20
+    /// Quiet period after the last keystroke before a search runs; changes apply to the next keystroke.
+    public var searchDebounceMilliseconds = 500
+    /// Searches names locally, tolerating typos, instead of with the API's substring match.
+    public var usesFuzzySearch = false
+    /// Results kept per fuzzy search keystroke.
+    public var fuzzySearchLimit = 20
+    
+    private var isOffline: Bool {
+        return reachability?.isReachable == false
+    }
+    
+    public init(repository: CharacterRepositoryProtocol = CharacterRepository(),
+                reachability: ReachabilityMonitoring? = nil,
+                analytics: Analytics? = nil,
+                scheduler: CoreScheduler = CoreSchedulers.main) {
+        self.repository = repository
+        self.reachability = reachability
+        self.analytics = analytics
+        self.scheduler = scheduler
+        setupSearch()
+        setupReachability()
+        setupFacetIndex()
+    }
+    
+    /// `characters` narrowed by `filter`. Without a selection it is `characters` itself, so the
+    /// first page is not held back by the index build.
+    public var visibleCharacters: AnyPublisher<[Character], Never> {
+        return filter
+            .removeDuplicates()
+            .map { [unowned self] (filter) -> AnyPublisher<[Character], Never> in
+                guard !filter.isEmpty else { return self.characters.eraseToAnyPublisher() }
+                return self.facetIndex.map { $0.characters(matching: filter) }.eraseToAnyPublisher()
+            }
+            .switchToLatest()
+            .eraseToAnyPublisher()
+    }
+    
+    /// Live counts for the filter chips: popcounts over the index, never a scan of the characters.
+    public var facetCounts: AnyPublisher<[CharacterFacet: [FacetValueCount]], Never> {
+        return facetIndex
+            .combineLatest(filter)
+            .map { (index, filter) in index.facetCounts(for: filter) }
+            .eraseToAnyPublisher()
+    }
+    
+    /// `visibleCharacters` sorted and grouped by `layout`, off the main thread. Pages arriving are
+    /// merged into the sort permutations and a layout change only walks one of them.
+    public var sectionedCharacters: AnyPublisher<CharacterSectionedList, Never> {
+        let index = CharacterSortIndex()
+        return visibleCharacters
+            .combineLatest(layout.removeDuplicates())
+            .receive(on: CoreSchedulers.queue(indexQueue))
+            .map { (characters, layout) -> CharacterSectionedList in
+                index.update(with: characters)
+                return CharacterSectionedList(characters: index.characters, sections: index.sections(for: layout))
+            }
+            .receive(on: scheduler)
+            .eraseToAnyPublisher()
+    }
+    
+    public func toggleFilter(_ value: String, in facet: CharacterFacet) {
+        filter.send(filter.value.toggling(value, in: facet))
+    }
+    
+    public func setupSearch() {
+        searchText
+            .removeDuplicates()
+            // A debounce whose interval is read per keystroke, so tuning applies without resubscribing.
+            .map { [unowned self] (searchText) in
+                Just(searchText).delay(for: .milliseconds(self.searchDebounceMilliseconds), scheduler: self.scheduler)
+            }
+            .switchToLatest()
+            .map { [unowned self] (searchText) -> AnyPublisher<[Character], Never> in
+                let start = DispatchTime.now().uptimeNanoseconds
+                let results = self.usesFuzzySearch && !searchText.isEmpty
+                    ? self.repository.fuzzySearchCharacter(name: searchText, limit: self.fuzzySearchLimit)
+                    : self.repository.searchCharacter(with: "name=\(searchText)")
+                
+                return results
+                    .tracked(as: "search", in: self.subscriptions)
+                    .catch { (error) in
+                        Just([Character]())
+                    }
+                    .handleEvents(receiveOutput: { [analytics = self.analytics] _ in
+                        let elapsed = DispatchTime.now().uptimeNanoseconds - start
+                        analytics?.record(.searchLatency, value: Double(elapsed) / 1_000_000)
+                    })
+                    .eraseToAnyPublisher()
+            }
+            .switchToLatest()
+            .sink { [unowned self] (characters) in
+                self.characters.send(characters)
+            }.store(in: &bindings)
+    }
+    
+    private func setupReachability() {
+        reachability?.reachability
+            .dropFirst()
+            .receive(on: scheduler)
+            .sink { [unowned self] (isReachable) in
+                if !isReachable {
+                    self.state.send(.offline)
+                } else if case .offline = self.state.value {
+                    self.fetchCharacters()
+                }
+            }.store(in: &bindings)
+    }
+    
+    private func setupFacetIndex() {
+        characters
+            .receive(on: CoreSchedulers.queue(indexQueue))
+            .map(CharacterFacetIndex.init(characters:))
+            .receive(on: scheduler)
+            .sink { [unowned self] (index) in
+                self.facetIndex.send(index)
+            }.store(in: &bindings)
+    }
+    
+    /// Call when the search bar gains focus, so the first keystroke does not wait for the local index.
+    public func prepareSearch() {
+        if usesFuzzySearch {
+            repository.prepareFuzzySearch()
+        }
+    }
+    
+    /// Requests in flight, at most one per `Intent`.
+    public var activeRequestCount: Int {
+        return requests.count
+    }
+    
+    /// Applies the tuning knobs that live in the view model.
+    public func apply(_ config: ExperimentConfig) {
+        pageSize = config.pageSize
+        searchDebounceMilliseconds = config.searchDebounceMilliseconds
+        usesFuzzySearch = config.usesFuzzySearch
+    }
+    
+    /// Loads the first `pageSize` rows, cancelling a load still in flight (a retry, a refresh or a
+    /// reconnection superseding it).
+    public func fetchCharacters() {
+        state.send(.loading)
+        
+        let start = DispatchTime.now().uptimeNanoseconds
+        let pageCount = max(1, (pageSize + 19) / 20)
+        let pages = (1...pageCount).map { page in
+            (page == 1 ? repository.fetchCharacters() : repository.fetchCharacters(page: page))
+                .map { (page, $0) }
+        }
+        var loaded = [Int: [Character]]()
+        
+        requests.start(.load) { (finished) in
+            Publishers.MergeMany(pages)
+                .tracked(as: "fetch", in: subscriptions)
+                .sink { [unowned self] (completion) in
+                    switch completion {
+                    case .failure(RepositoryError.offline): self.state.send(.offline)
+                    case .failure(let error): self.state.send(.error(error))
+                    case .finished: self.state.send(self.isOffline ? .offline : .finished)
+                    }
+                    finished()
+                } receiveValue: { [unowned self] (page, characters) in
+                    if loaded.isEmpty {
+                        let elapsed = DispatchTime.now().uptimeNanoseconds - start
+                        self.analytics?.record(.pageLoadLatency, value: Double(elapsed) / 1_000_000)
+                    }
+                    loaded[page] = characters
+                    self.characters.send(loaded.keys.sorted().flatMap { loaded[$0] ?? [] })
+                }
+        }
+    }
+}
@@ -0,0 +1,172 @@
+//
+//  CatalogueDeltaSyncTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+@testable import RickAndMortyCore
+
+final class CatalogueDeltaSyncTests: XCTestCase {
+    private let queue = DispatchQueue(label: "RickAndMortyCoreTests.delta-sync")
+    private var store: CharacterStore!
+    private var service: StubCharacterService!
+    private var sync: CatalogueDeltaSync!
+
+    override func setUp() {
+        super.setUp()
+        StubCharacterURLProtocol.reset()
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StubCharacterURLProtocol.self]
+        store = CharacterStore(fileURL: nil)
+        service = StubCharacterService(count: 826)
+        sync = CatalogueDeltaSync(service: service,
+                                  characters: ResourceApiService(session: URLSession(configuration: configuration),
+                                                                 scheduler: CoreSchedulers.queue(queue)),
+                                  store: store)
+    }
+
+    private func savePages(_ pages: [Int]) {
+        for page in pages {
+            store.save(TestCharacters.catalogue((page - 1) * 20 + 1...page * 20), page: page)
+        }
+    }
+
+    private func refresh() throws -> CatalogueRefresh {
+        let finished = expectation(description: "refresh")
+        var result: Result<CatalogueRefresh, Error>?
+        let cancellable = sync.refresh().sink(receiveCompletion: { completion in
+            if case .failure(let error) = completion {
+                result = .failure(error)
+            }
+            finished.fulfill()
+        }, receiveValue: { refresh in
+            result = .success(refresh)
+        })
+        wait(for: [finished], timeout: 10)
+        withExtendedLifetime(cancellable) {}
+        return try XCTUnwrap(result).get()
+    }
+
+    func testHighWaterMarkFollowsGaplessPages() {
+        XCTAssertEqual(store.catalogueHighWaterMark(), 0)
+
+        savePages([1, 2, 4])
+        XCTAssertEqual(store.catalogueHighWaterMark(), 40)
+
+        savePages([3])
+        XCTAssertEqual(store.catalogueHighWaterMark(), 80)
+    }
+
+    /// A search hit far above the cached pages must not hide the ids between them.
+    func testHighWaterMarkIgnoresCharactersSavedFromSearches() {
+        savePages([1, 2, 3])
+        store.save([TestCharacters.character(id: 800)], query: "name=morty")
+
+        XCTAssertEqual(store.catalogueHighWaterMark(), 60)
+    }
+
+    func testRefreshFetchesEveryIDAboveTheCachedPages() throws {
+        savePages([1, 2, 3])
+        store.save([TestCharacters.character(id: 800)], query: "name=morty")
+
+        let refresh = try self.refresh()
+
+        XCTAssertEqual(refresh.count, 826)
+        XCTAssertEqual(refresh.newCharacters, 826 - 60)
+        XCTAssertEqual(StubCharacterURLProtocol.requestedIDs.sorted(), Array(61...826))
+        XCTAssertTrue(refresh.revalidatedPages.allSatisfy { (1...3).contains($0) }, "\(refresh.revalidatedPages)")
+        XCTAssertEqual(store.characters(page: 4)?.map(\.id), Array(61...80))
+        XCTAssertEqual(store.characters(page: 40)?.map(\.id), Array(781...800))
+        XCTAssertEqual(store.characters(page: 42)?.map(\.id), Array(821...826))
+        XCTAssertEqual(store.characters(query: "name=morty")?.map(\.id), [800])
+        XCTAssertEqual(store.catalogueHighWaterMark(), 826)
+    }
+
+    func testRefreshOfAnUpToDateCatalogueFetchesNoIDs() throws {
+        savePages(Array(1...41))
+        store.save(TestCharacters.catalogue(821...826), page: 42)
+
+        let refresh = try self.refresh()
+
+        XCTAssertEqual(refresh.newCharacters, 0)
+        XCTAssertTrue(StubCharacterURLProtocol.requestedIDs.isEmpty)
+        XCTAssertEqual(refresh.revalidatedPages.count, 2)
+        XCTAssertEqual(store.catalogueState?.pages, 42)
+    }
+}
+
+/// `count` dense characters, 20 per page, answered at once.
+private final class StubCharacterService: CharacterApiServiceProtocol {
+    let count: Int
+
+    init(count: Int) {
+        self.count = count
+    }
+
+    private func page(_ page: Int) -> AnyPublisher<[Character], Error> {
+        let ids = (page - 1) * 20 + 1...min(page * 20, count)
+        return Just(TestCharacters.catalogue(ids)).setFailureType(to: Error.self).eraseToAnyPublisher()
+    }
+
+    func fetchCharacters() -> AnyPublisher<[Character], Error> {
+        return page(1)
+    }
+
+    func fetchCharacters(page: Int) -> AnyPublisher<[Character], Error> {
+        return self.page(page)
+    }
+
+    func searchCharacter(with query: String) -> AnyPublisher<[Character], Error> {
+        return Fail(error: ServiceError.urlRequest).eraseToAnyPublisher()
+    }
+
+    func fetchInfo(page: Int) -> AnyPublisher<PageInfo, Error> {
+        return Just(PageInfo(count: count, pages: (count + 19) / 20)).setFailureType(to: Error.self).eraseToAnyPublisher()
+    }
+}
+
+/// Answers the multi-id endpoint, `/api/character/1,2,3`, with `TestCharacters`.
+final class StubCharacterURLProtocol: URLProtocol {
+    private static let lock = NSLock()
+    private static var _requestedIDs = [Int]()
+
+    static var requestedIDs: [Int] {
+        lock.lock(); defer { lock.unlock() }
+        return _requestedIDs
+    }
+
+    static func reset() {
+        lock.lock(); defer { lock.unlock() }
+        _requestedIDs = []
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool {
+        return request.url?.path.hasPrefix("/api/character/") == true
+    }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+        return request
+    }
+
+    override func startLoading() {
+        guard let url = request.url else { return }
+        let ids = url.lastPathComponent.split(separator: ",").compactMap { Int($0) }
+        StubCharacterURLProtocol.lock.lock()
+        StubCharacterURLProtocol._requestedIDs.append(contentsOf: ids)
+        StubCharacterURLProtocol.lock.unlock()
+
+        let body = (try? JSONEncoder().encode(ids.map { TestCharacters.character(id: $0) })) ?? Data()
+        let response = HTTPURLResponse(url: url, statusCode: 200, httpVersion: "HTTP/1.1",
+                                       headerFields: ["Content-Type": "application/json"])!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        client?.urlProtocol(self, didLoad: body)
+        client?.urlProtocolDidFinishLoading(self)
+    }
+
+    override func stopLoading() {}
+}
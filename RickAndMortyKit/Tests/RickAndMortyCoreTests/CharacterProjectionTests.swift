@@ -0,0 +1,163 @@
+//
+//  CharacterProjectionTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+/// GraphQL selections and decoding, and how the store keeps records fetched with a projection.
+final class CharacterProjectionTests: XCTestCase {
+    private static let listResponse = """
+    {"data": {"characters": {"results": [
+        {"id": "1", "name": "Rick Sanchez", "status": "Alive", "gender": "Male",
+         "image": "https://rickandmortyapi.com/api/character/avatar/1.jpeg", "location": {"name": "Citadel of Ricks"},
+         "episode": [{"id": "1"}, {"id": "2"}]},
+        {"id": "2", "name": "Morty Smith", "status": "Alive", "gender": "Male",
+         "image": "https://rickandmortyapi.com/api/character/avatar/2.jpeg", "location": {"name": "Citadel of Ricks"}}
+    ]}}}
+    """
+
+    private var directory: URL!
+
+    override func setUp() {
+        super.setUp()
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    private func decode(_ json: String) throws -> [Character] {
+        return try GraphQLCharacterService.decode(Data(json.utf8))
+    }
+
+    func testSelections() {
+        XCTAssertEqual(CharacterProjection.list.selection, "id name status gender location { name } image")
+        XCTAssertEqual(CharacterProjection([.originURL, .episodeIDs]).selection, "id origin { url } episode { id }")
+        XCTAssertEqual(CharacterProjection.all.selection,
+                       "id name status species type gender origin { name url } location { name url } image episode { id } url created")
+    }
+
+    func testDecodedEpisodesAreRESTURLs() throws {
+        let characters = try decode(CharacterProjectionTests.listResponse)
+
+        XCTAssertEqual(characters.map(\.id), [1, 2])
+        XCTAssertEqual(characters[0].episode, ["https://rickandmortyapi.com/api/episode/1",
+                                               "https://rickandmortyapi.com/api/episode/2"])
+        XCTAssertEqual(characters[1].episode, [])
+        XCTAssertEqual(characters[0].species, "")
+        XCTAssertNil(characters[0].location.url)
+    }
+
+    func testMalformedResponsesAreDecodeErrors() {
+        for json in [#"{"data": {"characters": {"results": [{"id": "one", "name": "Rick"}]}}}"#,
+                     #"{"data": {"characters": null}}"#,
+                     #"{"errors": [{"message": "boom"}]}"#] {
+            XCTAssertThrowsError(try decode(json), json) { error in
+                guard case .decode? = error as? ServiceError else {
+                    return XCTFail("\(error)")
+                }
+            }
+        }
+    }
+
+    func testMergeOnlyTakesTheProjectedFields() throws {
+        let stored = TestCharacters.character(id: 1)
+        let fetched = try decode(CharacterProjectionTests.listResponse)[0]
+
+        let merged = CharacterProjection.list.merge(fetched, into: stored)
+
+        XCTAssertEqual(merged.name, "Rick Sanchez")
+        XCTAssertEqual(merged.location.name, "Citadel of Ricks")
+        XCTAssertEqual(merged.location.url, stored.location.url)
+        XCTAssertEqual(merged.species, stored.species)
+        XCTAssertEqual(merged.origin.url, stored.origin.url)
+        XCTAssertEqual(merged.episode, stored.episode)
+        XCTAssertEqual(merged.url, stored.url)
+    }
+
+    func testPartialFetchOfAStoredCharacterKeepsItsOtherFields() throws {
+        let store = CharacterStore(fileURL: nil)
+        let stored = TestCharacters.character(id: 1)
+        store.save([stored], page: 1)
+        store.save(try decode(CharacterProjectionTests.listResponse), page: 1, projection: .list)
+
+        XCTAssertFalse(store.isPartial(id: 1))
+        XCTAssertTrue(store.isPartial(id: 2))
+        XCTAssertEqual(store.characters(page: 1)?.first?.name, "Rick Sanchez")
+        XCTAssertEqual(store.characters(page: 1)?.first?.species, stored.species)
+    }
+
+    /// Partial records are persisted without entering the snapshot, so it only ever holds whole ones.
+    func testPartialCharactersStayOutOfTheSnapshotUntilFullyFetched() throws {
+        let fileURL = directory.appendingPathComponent("characters.json")
+        let snapshotURL = CharacterStore.snapshotURL(for: fileURL)
+
+        let store = CharacterStore(fileURL: fileURL)
+        store.save(try decode(CharacterProjectionTests.listResponse), page: 1, projection: .list)
+        store.flush()
+
+        XCTAssertEqual(try CharacterSnapshot(contentsOf: snapshotURL).count, 0)
+        let relaunched = CharacterStore(fileURL: fileURL)
+        XCTAssertEqual(relaunched.characters(page: 1)?.map(\.name), ["Rick Sanchez", "Morty Smith"])
+        XCTAssertTrue(relaunched.isPartial(id: 1))
+
+        relaunched.save(TestCharacters.catalogue(1...2), page: 1)
+        relaunched.flush()
+
+        XCTAssertEqual(try CharacterSnapshot(contentsOf: snapshotURL).ids, [1, 2])
+        let whole = CharacterStore(fileURL: fileURL)
+        XCTAssertFalse(whole.isPartial(id: 1))
+        XCTAssertEqualCharacters(whole.characters(page: 1) ?? [], TestCharacters.catalogue(1...2))
+    }
+
+    /// A response is stored with the projection it was requested with, even if the transport
+    /// changed while it was in flight.
+    func testSyncStoresResponsesWithTheProjectionTheyWereRequestedWith() throws {
+        let queue = DispatchQueue(label: "RickAndMortyCoreTests.projection")
+        let store = CharacterStore(fileURL: nil)
+        let journal = QueryJournal(fileURL: nil)
+        let service = SwitchingCharacterService()
+        let coordinator = CharacterSyncCoordinator(service: service,
+                                                   offline: OfflineSupport(store: store, journal: journal,
+                                                                           reachability: ManualReachability(isReachable: true)),
+                                                   scheduler: CoreSchedulers.queue(queue))
+        journal.record("name=rick")
+        queue.sync { coordinator.sync() }
+
+        service.projection = .all
+        service.response.send(try decode(CharacterProjectionTests.listResponse))
+        service.response.send(completion: .finished)
+        queue.sync {}
+
+        XCTAssertTrue(store.isPartial(id: 1))
+        XCTAssertEqual(journal.pendingQueries(), [])
+    }
+}
+
+/// Answers every search with `response`; `projection` can be changed while it is in flight.
+private final class SwitchingCharacterService: CharacterApiServiceProtocol {
+    var projection = CharacterProjection.list
+    let response = PassthroughSubject<[Character], Error>()
+
+    func fetchCharacters() -> AnyPublisher<[Character], Error> {
+        return response.eraseToAnyPublisher()
+    }
+
+    func fetchCharacters(page: Int) -> AnyPublisher<[Character], Error> {
+        return response.eraseToAnyPublisher()
+    }
+
+    func searchCharacter(with query: String) -> AnyPublisher<[Character], Error> {
+        return response.eraseToAnyPublisher()
+    }
+
+    func fetchInfo(page: Int) -> AnyPublisher<PageInfo, Error> {
+        return Fail(error: ServiceError.urlRequest).eraseToAnyPublisher()
+    }
+}
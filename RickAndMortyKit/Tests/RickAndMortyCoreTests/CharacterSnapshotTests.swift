@@ -0,0 +1,122 @@
+//
+//  CharacterSnapshotTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class CharacterSnapshotTests: XCTestCase {
+    func testRoundTrip() throws {
+        let characters = TestCharacters.catalogue(1...120)
+        let snapshot = try CharacterSnapshot(data: CharacterSnapshot.encode(characters))
+
+        XCTAssertEqual(snapshot.count, characters.count)
+        XCTAssertEqual(snapshot.ids, characters.map(\.id))
+        XCTAssertEqualCharacters((0..<snapshot.count).map(snapshot.character(at:)), characters)
+        XCTAssertEqualCharacters(characters.compactMap { snapshot.character(id: $0.id) }, characters)
+        XCTAssertNil(snapshot.character(id: 121))
+        XCTAssertNil(snapshot.character(id: 0))
+    }
+
+    func testRoundTripOfUnsortedInput() throws {
+        let characters = Array(TestCharacters.catalogue(1...40).reversed())
+        let snapshot = try CharacterSnapshot(data: CharacterSnapshot.encode(characters))
+
+        XCTAssertEqualCharacters((1...40).compactMap(snapshot.character(id:)), Array(characters.reversed()))
+    }
+
+    func testEmptySnapshot() throws {
+        let snapshot = try CharacterSnapshot(data: CharacterSnapshot.encode([]))
+
+        XCTAssertEqual(snapshot.count, 0)
+        XCTAssertNil(snapshot.character(id: 1))
+    }
+
+    /// Few replacements take the path copying records as they are; many re-encode everything.
+    func testEncodeOverSnapshotMatchesFullEncode() throws {
+        let base = try CharacterSnapshot(data: CharacterSnapshot.encode(TestCharacters.catalogue(1...100)))
+
+        for changed in [[TestCharacters.character(id: 5, name: "Renamed")],
+                        [TestCharacters.character(id: 1, name: "First"), TestCharacters.character(id: 150)],
+                        TestCharacters.catalogue(90...140)] {
+            var expected = Dictionary(uniqueKeysWithValues: TestCharacters.catalogue(1...100).map { ($0.id, $0) })
+            for character in changed {
+                expected[character.id] = character
+            }
+            let merged = try CharacterSnapshot(data: CharacterSnapshot.encode(changed, over: base))
+
+            XCTAssertEqual(merged.count, expected.count)
+            XCTAssertEqualCharacters(expected.keys.sorted().compactMap(merged.character(id:)),
+                                     expected.keys.sorted().compactMap { expected[$0] })
+        }
+    }
+
+    func testEncodeOverEncodedSnapshotAgain() throws {
+        let base = try CharacterSnapshot(data: CharacterSnapshot.encode(TestCharacters.catalogue(1...100)))
+        let once = try CharacterSnapshot(data: CharacterSnapshot.encode([TestCharacters.character(id: 7, name: "Once")], over: base))
+        let twice = try CharacterSnapshot(data: CharacterSnapshot.encode([TestCharacters.character(id: 8, name: "Twice")], over: once))
+
+        XCTAssertEqual(twice.character(id: 7)?.name, "Once")
+        XCTAssertEqual(twice.character(id: 8)?.name, "Twice")
+        XCTAssertEqualCharacters([twice.character(id: 9)!], [TestCharacters.character(id: 9)])
+    }
+
+    func testTruncatedDataThrows() {
+        let data = CharacterSnapshot.encode(TestCharacters.catalogue(1...20))
+
+        for length in [0, 10, CharacterSnapshot.headerSize, data.count / 2, data.count - 1] {
+            XCTAssertThrowsError(try CharacterSnapshot(data: data.prefix(length)), "\(length) bytes") { error in
+                guard case CharacterSnapshot.Error.truncated = error else {
+                    return XCTFail("Unexpected error \(error) for \(length) bytes")
+                }
+            }
+        }
+    }
+
+    func testInvalidHeaderThrows() {
+        var badMagic = CharacterSnapshot.encode(TestCharacters.catalogue(1...5))
+        badMagic.replaceUInt32(at: 0, with: 0xDEAD_BEEF)
+        XCTAssertThrowsError(try CharacterSnapshot(data: badMagic)) { error in
+            guard case CharacterSnapshot.Error.invalidMagic = error else { return XCTFail("Unexpected error \(error)") }
+        }
+
+        var newerVersion = CharacterSnapshot.encode(TestCharacters.catalogue(1...5))
+        newerVersion.replaceUInt32(at: 4, with: CharacterSnapshot.version + 1)
+        XCTAssertThrowsError(try CharacterSnapshot(data: newerVersion)) { error in
+            guard case CharacterSnapshot.Error.unsupportedVersion = error else { return XCTFail("Unexpected error \(error)") }
+        }
+    }
+
+    func testOutOfBoundsReferencesThrow() {
+        let data = CharacterSnapshot.encode(TestCharacters.catalogue(1...5))
+        let indexOffset = Int(data.readUInt32(at: 16))
+        let recordsOffset = Int(data.readUInt32(at: 20))
+        let arenaLength = data.readUInt32(at: 28)
+
+        // An index entry naming a record past the last one.
+        var badRecord = data
+        badRecord.replaceUInt32(at: indexOffset + 4, with: 5)
+        // The name of the first record ending past the arena.
+        var badOffset = data
+        badOffset.replaceUInt32(at: recordsOffset + 4, with: arenaLength)
+        var badLength = data
+        badLength.replaceUInt32(at: recordsOffset + 8, with: arenaLength + 1)
+
+        for corrupt in [badRecord, badOffset, badLength] {
+            XCTAssertThrowsError(try CharacterSnapshot(data: corrupt)) { error in
+                guard case CharacterSnapshot.Error.corrupt = error else { return XCTFail("Unexpected error \(error)") }
+            }
+        }
+    }
+}
+
+private extension Data {
+    mutating func replaceUInt32(at offset: Int, with value: UInt32) {
+        var bytes = Data()
+        bytes.appendUInt32(value)
+        replaceSubrange(startIndex + offset..<startIndex + offset + 4, with: bytes)
+    }
+}
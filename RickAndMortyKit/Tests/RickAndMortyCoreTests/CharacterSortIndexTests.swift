@@ -0,0 +1,169 @@
+//
+//  CharacterSortIndexTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+/// Merged permutations against a plain sort of the whole list, and sectioned differences.
+final class CharacterSortIndexTests: XCTestCase {
+    /// Episodes listed out of air order, so the first one is not the first seen.
+    private static func character(id: Int, name: String? = nil, episodes: [Int]) -> Character {
+        var character = TestCharacters.character(id: id, name: name)
+        character.episode = episodes.map { "https://rickandmortyapi.com/api/episode/\($0)" }
+        return character
+    }
+
+    private static let catalogue: [Character] = (1...100).map { id in
+        var random = SeededRandomNumberGenerator(seed: UInt64(id))
+        let episodes = (0..<Int.random(in: 0...5, using: &random)).map { _ in Int.random(in: 1...51, using: &random) }
+        // Repeated names exercise the tie-break by id.
+        return CharacterSortIndexTests.character(id: id, name: TestCharacters.names[id % 7], episodes: episodes)
+    }
+
+    private static func sorted(_ characters: [Character], by order: CharacterSortOrder) -> [Int] {
+        func rank(_ status: String) -> Int {
+            return ["alive": 0, "dead": 1][status.lowercased()] ?? 2
+        }
+        let rows = characters.indices.sorted { lhs, rhs in
+            let left = characters[lhs], right = characters[rhs]
+            let tieBreak = (left.name.lowercased(), left.id) < (right.name.lowercased(), right.id)
+            switch order {
+            case .original:
+                return lhs < rhs
+            case .name:
+                return tieBreak
+            case .status:
+                return rank(left.status) != rank(right.status) ? rank(left.status) < rank(right.status) : tieBreak
+            case .episodeCount:
+                return left.episode.count != right.episode.count ? left.episode.count > right.episode.count : tieBreak
+            case .firstAppearance:
+                let leftFirst = left.episodeIDs.min() ?? Int.max, rightFirst = right.episodeIDs.min() ?? Int.max
+                return leftFirst != rightFirst ? leftFirst < rightFirst : tieBreak
+            }
+        }
+        return rows.map { characters[$0].id }
+    }
+
+    private func ids(_ index: CharacterSortIndex, _ order: CharacterSortOrder) -> [Int] {
+        return index.rows(sortedBy: order).map { index.characters[Int($0)].id }
+    }
+
+    func testPagesMergedInMatchAFullSort() {
+        let index = CharacterSortIndex()
+        for end in stride(from: 20, through: 100, by: 20) {
+            let loaded = Array(CharacterSortIndexTests.catalogue.prefix(end))
+            XCTAssertTrue(index.update(with: loaded))
+
+            for order in CharacterSortOrder.allCases {
+                XCTAssertEqual(ids(index, order), CharacterSortIndexTests.sorted(loaded, by: order), "\(order), \(end) characters")
+            }
+        }
+    }
+
+    func testChangedKeysRebuildEveryPermutation() {
+        var characters = CharacterSortIndexTests.catalogue
+        let index = CharacterSortIndex(characters: characters)
+        characters[10].name = "Aaa"
+        characters[20].status = "Dead"
+
+        XCTAssertFalse(index.update(with: characters))
+        for order in CharacterSortOrder.allCases {
+            XCTAssertEqual(ids(index, order), CharacterSortIndexTests.sorted(characters, by: order), "\(order)")
+        }
+    }
+
+    func testFirstAppearanceUsesTheEarliestEpisode() {
+        let characters = [CharacterSortIndexTests.character(id: 1, episodes: [30, 2]),
+                          CharacterSortIndexTests.character(id: 2, episodes: [5]),
+                          CharacterSortIndexTests.character(id: 3, episodes: [])]
+        let index = CharacterSortIndex(characters: characters)
+
+        XCTAssertEqual(ids(index, .firstAppearance), [1, 2, 3])
+        XCTAssertEqual(characters.map(\.firstEpisodeID), [2, 5, nil])
+
+        // Listing the same episodes in another order is not a key change.
+        var reordered = characters
+        reordered[0].episode.reverse()
+        XCTAssertTrue(index.update(with: reordered))
+    }
+
+    func testSectionsKeepTheSortOrder() {
+        let index = CharacterSortIndex(characters: CharacterSortIndexTests.catalogue)
+        let sections = index.sections(for: CharacterListLayout(order: .name, grouping: .species))
+
+        XCTAssertEqual(sections.map(\.title), ["Alien", "Human"])
+        let byName = CharacterSortIndexTests.sorted(CharacterSortIndexTests.catalogue, by: .name)
+        for section in sections {
+            let sectionIDs = section.rows.map { index.characters[Int($0)].id }
+            XCTAssertEqual(sectionIDs, byName.filter { sectionIDs.contains($0) })
+        }
+    }
+
+    // MARK: - Differences
+
+    private func list(_ characters: [Character], _ layout: CharacterListLayout) -> CharacterSectionedList {
+        let index = CharacterSortIndex(characters: characters)
+        return CharacterSectionedList(characters: index.characters, sections: index.sections(for: layout))
+    }
+
+    func testIdenticalListsHaveNoDifference() {
+        let layout = CharacterListLayout(order: .name, grouping: .species)
+        let old = list(CharacterSortIndexTests.catalogue, layout)
+
+        XCTAssertTrue(list(CharacterSortIndexTests.catalogue, layout).difference(from: old).isEmpty)
+    }
+
+    func testRowsAreDeletedInsertedAndReloaded() {
+        let layout = CharacterListLayout(order: .original, grouping: .none)
+        let characters = TestCharacters.catalogue(1...5)
+        var changed = characters
+        changed.remove(at: 1)
+        changed.append(TestCharacters.character(id: 6))
+        changed[2].image = "https://rickandmortyapi.com/api/character/avatar/refreshed.jpeg"
+
+        let difference = list(changed, layout).difference(from: list(characters, layout))
+
+        XCTAssertEqual(difference.deletedRows, [SectionedDifference.Position(section: 0, row: 1)])
+        XCTAssertEqual(difference.insertedRows, [SectionedDifference.Position(section: 0, row: 4)])
+        // Character 4, the third row after the deletion, was the fourth before it.
+        XCTAssertEqual(difference.reloadedRows, [SectionedDifference.Position(section: 0, row: 3)])
+        XCTAssertEqual(difference.changeCount, 3)
+    }
+
+    func testMovedRowsAreNotReloaded() {
+        let layout = CharacterListLayout(order: .name, grouping: .none)
+        var characters = TestCharacters.catalogue(1...5)
+        let old = list(characters, layout)
+        characters[0].name = "Aaa"
+
+        let difference = list(characters, layout).difference(from: old)
+
+        XCTAssertTrue(difference.reloadedRows.isEmpty)
+        XCTAssertEqual(difference.deletedRows.count, 1)
+        XCTAssertEqual(difference.insertedRows.count, 1)
+    }
+
+    func testCharactersChangingSectionMoveBetweenSections() {
+        let layout = CharacterListLayout(order: .original, grouping: .species)
+        let characters = TestCharacters.catalogue(1...10)
+        var changed = characters
+        changed[4].species = "Human"
+        changed[9].species = "Robot"
+
+        let old = list(characters, layout)
+        let new = list(changed, layout)
+        let difference = new.difference(from: old)
+
+        XCTAssertEqual(old.sections.map(\.title), ["Alien", "Human"])
+        XCTAssertEqual(new.sections.map(\.title), ["Human", "Robot"])
+        XCTAssertEqual(difference.deletedSections, IndexSet(integer: 0))
+        XCTAssertEqual(difference.insertedSections, IndexSet(integer: 1))
+        XCTAssertEqual(difference.insertedRows, [SectionedDifference.Position(section: 0, row: 4)])
+        XCTAssertTrue(difference.deletedRows.isEmpty)
+        XCTAssertTrue(difference.reloadedRows.isEmpty)
+    }
+}
@@ -0,0 +1,130 @@
+//
+//  CharacterSyncCoordinatorTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class CharacterSyncCoordinatorTests: XCTestCase {
+    private let queue = DispatchQueue(label: "RickAndMortyCoreTests.sync")
+    private var store: CharacterStore!
+    private var journal: QueryJournal!
+    private var reachability: ManualReachability!
+    private var service: RecordingCharacterService!
+    private var coordinator: CharacterSyncCoordinator!
+    private var bindings = Set<AnyCancellable>()
+
+    override func setUp() {
+        super.setUp()
+        store = CharacterStore(fileURL: nil)
+        journal = QueryJournal(fileURL: nil)
+        reachability = ManualReachability(isReachable: false)
+        service = RecordingCharacterService()
+        coordinator = CharacterSyncCoordinator(service: service,
+                                               offline: OfflineSupport(store: store, journal: journal, reachability: reachability),
+                                               scheduler: CoreSchedulers.queue(queue))
+        coordinator.start()
+    }
+
+    override func tearDown() {
+        bindings.removeAll()
+        super.tearDown()
+    }
+
+    /// Reconnects and returns the sync's `finished` counts.
+    private func reconnect() -> (requests: Int, failures: Int)? {
+        let finished = expectation(description: "sync finished")
+        var counts: (requests: Int, failures: Int)?
+        coordinator.events
+            .sink { event in
+                if case .finished(let requests, let failures) = event {
+                    counts = (requests, failures)
+                    finished.fulfill()
+                }
+            }
+            .store(in: &bindings)
+        reachability.set(reachable: true)
+        wait(for: [finished], timeout: 5)
+        return counts
+    }
+
+    func testReconnectRefreshesStalePagesAndReplaysJournaledSearches() {
+        store.save(TestCharacters.catalogue(1...20), page: 1)
+        store.save(TestCharacters.catalogue(21...40), page: 2, at: Date() - 2 * 60 * 60)
+        store.save([TestCharacters.character(id: 2)], query: "name=morty")
+        journal.record("name=rick", at: Date() - 60)
+        journal.record("name=morty", at: Date() - 30)
+
+        let counts = reconnect()
+
+        XCTAssertEqual(counts?.requests, 2)
+        XCTAssertEqual(counts?.failures, 0)
+        XCTAssertEqual(service.pages, [2])
+        // Still fresh in the store, so not requested again.
+        XCTAssertEqual(service.queries, ["name=rick"])
+        XCTAssertEqual(store.characters(query: "name=rick")?.map(\.id), [1])
+        XCTAssertEqual(journal.pendingQueries(), [])
+    }
+
+    func testFailedSearchesStayInTheJournal() {
+        service.failsSearches = true
+        journal.record("name=rick", at: Date() - 60)
+
+        let counts = reconnect()
+
+        XCTAssertEqual(counts?.failures, 1)
+        XCTAssertEqual(journal.pendingQueries(), ["name=rick"])
+    }
+
+    func testNothingIsRequestedWhileOffline() {
+        journal.record("name=rick", at: Date() - 60)
+        queue.sync {
+            coordinator.sync()
+        }
+
+        XCTAssertEqual(service.queries, [])
+        XCTAssertEqual(journal.pendingQueries(), ["name=rick"])
+    }
+}
+
+/// Records the requests made and answers them at once.
+private final class RecordingCharacterService: CharacterApiServiceProtocol {
+    private let lock = NSLock()
+    private var _pages = [Int]()
+    private var _queries = [String]()
+    var failsSearches = false
+
+    var pages: [Int] {
+        lock.lock(); defer { lock.unlock() }
+        return _pages
+    }
+
+    var queries: [String] {
+        lock.lock(); defer { lock.unlock() }
+        return _queries
+    }
+
+    func fetchCharacters() -> AnyPublisher<[Character], Error> {
+        return fetchCharacters(page: 1)
+    }
+
+    func fetchCharacters(page: Int) -> AnyPublisher<[Character], Error> {
+        lock.lock(); _pages.append(page); lock.unlock()
+        return Just(TestCharacters.catalogue((page - 1) * 20 + 1...page * 20)).setFailureType(to: Error.self).eraseToAnyPublisher()
+    }
+
+    func searchCharacter(with query: String) -> AnyPublisher<[Character], Error> {
+        lock.lock(); _queries.append(query); lock.unlock()
+        guard !failsSearches else {
+            return Fail(error: ServiceError.urlRequest).eraseToAnyPublisher()
+        }
+        return Just([TestCharacters.character(id: 1)]).setFailureType(to: Error.self).eraseToAnyPublisher()
+    }
+
+    func fetchInfo(page: Int) -> AnyPublisher<PageInfo, Error> {
+        return Just(PageInfo(count: 826, pages: 42)).setFailureType(to: Error.self).eraseToAnyPublisher()
+    }
+}
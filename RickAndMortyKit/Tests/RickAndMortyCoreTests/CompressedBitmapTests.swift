@@ -0,0 +1,90 @@
+//
+//  CompressedBitmapTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+/// Every operation against the same one on `Set<Int>`, for bitmaps mixing sparse chunks (arrays)
+/// and dense ones (bitsets).
+final class CompressedBitmapTests: XCTestCase {
+    private var random = SeededRandomNumberGenerator(seed: 42)
+
+    /// `density` of the rows in each of `chunks` chunks of 65,536 rows; dense chunks become bitsets.
+    private func randomRows(chunks: [Int], density: Double) -> Set<Int> {
+        var rows = Set<Int>()
+        for chunk in chunks {
+            for offset in 0..<65_536 where Double.random(in: 0..<1, using: &random) < density {
+                rows.insert((chunk << 16) + offset)
+            }
+        }
+        return rows
+    }
+
+    private var samples: [Set<Int>] {
+        return [
+            [],
+            [0],
+            Set(0..<10),
+            randomRows(chunks: [0, 2], density: 0.01),
+            randomRows(chunks: [0, 1], density: 0.3),
+            randomRows(chunks: [1, 3], density: 0.9),
+            randomRows(chunks: [0], density: 0.0625).union(randomRows(chunks: [2], density: 0.5))
+        ]
+    }
+
+    func testRowsAndCount() {
+        for rows in samples {
+            let bitmap = CompressedBitmap(sortedRows: rows.sorted())
+            XCTAssertEqual(bitmap.rows, rows.sorted())
+            XCTAssertEqual(bitmap.count, rows.count)
+            XCTAssertEqual(bitmap.isEmpty, rows.isEmpty)
+        }
+    }
+
+    func testContains() {
+        for rows in samples {
+            let bitmap = CompressedBitmap(sortedRows: rows.sorted())
+            for row in stride(from: 0, to: 4 << 16, by: 97) {
+                XCTAssertEqual(bitmap.contains(row), rows.contains(row), "row \(row)")
+            }
+        }
+    }
+
+    func testSetOperations() {
+        let samples = self.samples
+        for lhs in samples {
+            for rhs in samples {
+                let left = CompressedBitmap(sortedRows: lhs.sorted())
+                let right = CompressedBitmap(sortedRows: rhs.sorted())
+                let intersection = lhs.intersection(rhs)
+
+                XCTAssertEqual(left.intersection(right).rows, intersection.sorted())
+                XCTAssertEqual(left.intersection(right).count, intersection.count)
+                XCTAssertEqual(left.intersectionCount(right), intersection.count)
+                XCTAssertEqual(left.union(right).rows, lhs.union(rhs).sorted())
+                XCTAssertEqual(left.union(right).count, lhs.union(rhs).count)
+            }
+        }
+    }
+
+    /// Intersections and unions are kept in the layout the rows would get if built from scratch.
+    func testResultsMatchFreshBitmaps() {
+        let samples = self.samples
+        for lhs in samples {
+            for rhs in samples {
+                let left = CompressedBitmap(sortedRows: lhs.sorted())
+                let right = CompressedBitmap(sortedRows: rhs.sorted())
+                XCTAssertEqual(left.intersection(right), CompressedBitmap(sortedRows: lhs.intersection(rhs).sorted()))
+            }
+        }
+    }
+
+    func testAll() {
+        XCTAssertEqual(CompressedBitmap.all(count: 70_000).rows, Array(0..<70_000))
+        XCTAssertEqual(CompressedBitmap.all(count: 0), CompressedBitmap())
+    }
+}
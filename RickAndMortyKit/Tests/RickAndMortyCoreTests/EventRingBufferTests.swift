@@ -0,0 +1,61 @@
+//
+//  EventRingBufferTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class EventRingBufferTests: XCTestCase {
+    func testCapacityIsRoundedUpToAPowerOfTwo() {
+        XCTAssertEqual(EventRingBuffer<Int>(capacity: 1).capacity, 2)
+        XCTAssertEqual(EventRingBuffer<Int>(capacity: 5).capacity, 8)
+        XCTAssertEqual(EventRingBuffer<Int>(capacity: 1024).capacity, 1024)
+    }
+
+    func testFullRingDropsPushesUntilPopped() {
+        let buffer = EventRingBuffer<Int>(capacity: 4)
+        for value in 0..<4 {
+            XCTAssertTrue(buffer.push(value))
+        }
+        XCTAssertFalse(buffer.push(4))
+
+        XCTAssertEqual(buffer.pop(), 0)
+        XCTAssertTrue(buffer.push(5))
+        XCTAssertEqual((0..<5).map { _ in buffer.pop() }, [1, 2, 3, 5, nil])
+    }
+
+    /// Producers retry on a full ring, so every element must come out exactly once and in the
+    /// order its producer pushed it.
+    func testConcurrentProducersLoseNothing() {
+        let producers = 8
+        let perProducer = 20_000
+        let buffer = EventRingBuffer<(producer: Int, sequence: Int)>(capacity: 256)
+        let group = DispatchGroup()
+
+        for producer in 0..<producers {
+            DispatchQueue.global().async(group: group) {
+                for sequence in 0..<perProducer {
+                    while !buffer.push((producer, sequence)) {}
+                }
+            }
+        }
+
+        var next = [Int](repeating: 0, count: producers)
+        var received = 0
+        let deadline = Date() + 30
+        while received < producers * perProducer, Date() < deadline {
+            guard let element = buffer.pop() else { continue }
+            XCTAssertEqual(element.sequence, next[element.producer], "producer \(element.producer)")
+            next[element.producer] = element.sequence + 1
+            received += 1
+        }
+
+        XCTAssertEqual(group.wait(timeout: .now() + 5), .success)
+        XCTAssertEqual(received, producers * perProducer)
+        XCTAssertEqual(next, [Int](repeating: perProducer, count: producers))
+        XCTAssertNil(buffer.pop())
+    }
+}
@@ -0,0 +1,131 @@
+//
+//  FirstSeenResolverTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class FirstSeenResolverTests: XCTestCase {
+    private let queue = DispatchQueue(label: "RickAndMortyCoreTests.first-seen")
+    private var episodes: StubEpisodeRepository!
+    private var resolver: FirstSeenResolver!
+    private var resolved = Set<Int>()
+    private var bindings = Set<AnyCancellable>()
+
+    override func setUp() {
+        super.setUp()
+        episodes = StubEpisodeRepository()
+        resolver = FirstSeenResolver(episodes: episodes, scheduler: CoreSchedulers.queue(queue))
+        resolver.resolved
+            .sink { [unowned self] in self.resolved.formUnion($0) }
+            .store(in: &bindings)
+    }
+
+    override func tearDown() {
+        bindings.removeAll()
+        super.tearDown()
+    }
+
+    /// Lets the scheduled flush and delivered responses run.
+    private func drain() {
+        queue.sync {}
+        queue.sync {}
+    }
+
+    private func character(id: Int, episodes: [Int]) -> Character {
+        var character = TestCharacters.character(id: id)
+        character.episode = episodes.map { "https://rickandmortyapi.com/api/episode/\($0)" }
+        return character
+    }
+
+    func testRowsResolvedInOneTurnCostOneRequest() {
+        let visible = TestCharacters.catalogue(1...12)
+        let prefetched = TestCharacters.catalogue(13...20) + [character(id: 21, episodes: [9, 3])]
+        queue.sync {
+            resolver.resolve(visible)
+            resolver.resolve(prefetched)
+        }
+        drain()
+
+        let firstEpisodes = Set((visible + prefetched).compactMap { $0.episodeIDs.min() })
+        XCTAssertEqual(episodes.requests, [firstEpisodes.sorted()])
+        XCTAssertEqual(resolver.requestCount, 1)
+
+        queue.sync { episodes.respond() }
+        drain()
+
+        let withEpisodes = (visible + prefetched).filter { !$0.episode.isEmpty }
+        XCTAssertEqual(resolved, Set(withEpisodes.map(\.id)))
+        XCTAssertEqual(resolver.episodeName(for: prefetched.last!), "Episode 3")
+    }
+
+    func testCharactersWaitingOnAnInFlightEpisodeAreNotRequestedAgain() {
+        queue.sync { resolver.resolve([character(id: 1, episodes: [1])]) }
+        drain()
+        queue.sync { resolver.resolve([character(id: 2, episodes: [1]), character(id: 3, episodes: [2])]) }
+        drain()
+
+        XCTAssertEqual(episodes.requests, [[1], [2]])
+
+        queue.sync { episodes.respond() }
+        drain()
+
+        XCTAssertEqual(resolved, [1, 2, 3])
+    }
+
+    func testCachedEpisodesAreNotRequested() {
+        queue.sync { resolver.resolve([character(id: 1, episodes: [1])]) }
+        drain()
+        queue.sync { episodes.respond() }
+        drain()
+
+        queue.sync { resolver.resolve([character(id: 2, episodes: [1, 4])]) }
+        drain()
+
+        XCTAssertEqual(episodes.requests, [[1]])
+        XCTAssertEqual(resolver.episodeName(for: character(id: 2, episodes: [4, 1])), "Episode 1")
+    }
+}
+
+/// Holds every request until `respond()`, then caches the episodes like `EpisodeRepository`.
+/// Only touched on the resolver's queue.
+private final class StubEpisodeRepository: EpisodeRepositoryProtocol {
+    private(set) var requests = [[Int]]()
+    private var cache = [Int: Episode]()
+    private var pending = [(ids: [Int], subject: PassthroughSubject<[Episode], Error>)]()
+
+    func cachedEpisode(id: Int) -> Episode? {
+        return cache[id]
+    }
+
+    func fetchEpisodes(ids: [Int]) -> AnyPublisher<[Episode], Error> {
+        requests.append(ids)
+        let subject = PassthroughSubject<[Episode], Error>()
+        pending.append((ids, subject))
+        return subject.eraseToAnyPublisher()
+    }
+
+    func respond() {
+        let responses = pending
+        pending.removeAll()
+        for response in responses {
+            let episodes = response.ids.map(StubEpisodeRepository.episode(id:))
+            for episode in episodes {
+                cache[episode.id] = episode
+            }
+            response.subject.send(episodes)
+            response.subject.send(completion: .finished)
+        }
+    }
+
+    static func episode(id: Int) -> Episode {
+        let json = """
+        {"id": \(id), "name": "Episode \(id)", "air_date": "December 2, 2013", "episode": "S01E\(id)",
+         "characters": [], "url": "https://rickandmortyapi.com/api/episode/\(id)", "created": "2017-11-10T12:56:33.798Z"}
+        """
+        return try! JSONDecoder().decode(Episode.self, from: Data(json.utf8))
+    }
+}
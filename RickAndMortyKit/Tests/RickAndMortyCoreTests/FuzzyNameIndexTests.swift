@@ -0,0 +1,108 @@
+//
+//  FuzzyNameIndexTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+/// The trigram filter and the bit-parallel matcher against a plain dynamic-programming scan of
+/// every name.
+final class FuzzyNameIndexTests: XCTestCase {
+    private static let names: [String] = {
+        let first = ["Rick", "Morty", "Summer", "Beth", "Jerry", "Squanchy", "Birdperson", "Tammy", "Unity", "Abradolf", "Évil"]
+        let last = ["Sanchez", "Smith", "Lincler", "Guetermann", "Poopybutthole", "Prime", "Toxic", "Cronenberg", "of C-137"]
+        return first.flatMap { first in last.map { "\(first) \($0)" } } + ["Mr. Meeseeks", "Noob-Noob", "Pickle Rick", "Rick"]
+    }()
+
+    private static let queries = ["rick", "mrty smith", "sumer smth", "Beth", "birdprson", "xyz", "abradolf lincler",
+                                  "toxc rick", "cronenbreg", "evil morty", "c137", "mr meeseks", "pickle", "r"]
+
+    /// Edit distance between `pattern` and its closest substring of `text`.
+    private static func bruteForceDistance(_ pattern: [UInt8], in text: [UInt8]) -> Int {
+        // Row 0 is all zeros: the match may start anywhere in the text.
+        var previous = [Int](repeating: 0, count: text.count + 1)
+        for (i, patternByte) in pattern.enumerated() {
+            var current = [Int](repeating: i + 1, count: text.count + 1)
+            for (j, textByte) in text.enumerated() {
+                current[j + 1] = min(previous[j + 1] + 1,
+                                     current[j] + 1,
+                                     previous[j] + (patternByte == textByte ? 0 : 1))
+            }
+            previous = current
+        }
+        return previous.min() ?? pattern.count
+    }
+
+    private static func bruteForceSearch(_ query: String, names: [String], limit: Int) -> [FuzzyMatch] {
+        let pattern = Array(FuzzyNameIndex.normalize(query).prefix(ApproximateMatcher.maxPatternLength))
+        guard !pattern.isEmpty else { return [] }
+        let maxErrors = FuzzyNameIndex.maxErrors(forLength: pattern.count)
+        let matches = names.enumerated().compactMap { entry -> (distance: Int, length: Int, row: Int)? in
+            let normalized = FuzzyNameIndex.normalize(entry.element)
+            let distance = bruteForceDistance(pattern, in: normalized)
+            return distance <= maxErrors ? (distance, normalized.count, entry.offset) : nil
+        }
+        return matches
+            .sorted { ($0.distance, $0.length, $0.row) < ($1.distance, $1.length, $1.row) }
+            .prefix(limit)
+            .map { FuzzyMatch(id: $0.row + 1, distance: $0.distance) }
+    }
+
+    private func makeIndex() -> FuzzyNameIndex {
+        return FuzzyNameIndex(entries: FuzzyNameIndexTests.names.enumerated().map { (id: $0.offset + 1, name: $0.element) })
+    }
+
+    func testMatcherAgainstDynamicProgramming() {
+        var random = SeededRandomNumberGenerator(seed: 7)
+        let alphabet = Array("abc ".utf8)
+        for _ in 0..<500 {
+            let pattern = (0..<Int.random(in: 1...12, using: &random)).map { _ in alphabet.randomElement(using: &random)! }
+            let text = (0..<Int.random(in: 0...30, using: &random)).map { _ in alphabet.randomElement(using: &random)! }
+            XCTAssertEqual(ApproximateMatcher(pattern: pattern).distance(in: text),
+                           FuzzyNameIndexTests.bruteForceDistance(pattern, in: text),
+                           "\(String(decoding: pattern, as: UTF8.self)) in \(String(decoding: text, as: UTF8.self))")
+        }
+    }
+
+    func testSearchMatchesBruteForce() {
+        let index = makeIndex()
+        for query in FuzzyNameIndexTests.queries {
+            for limit in [1, 5, 1000] {
+                XCTAssertEqual(index.search(query, limit: limit),
+                               FuzzyNameIndexTests.bruteForceSearch(query, names: FuzzyNameIndexTests.names, limit: limit),
+                               "\(query), limit \(limit)")
+            }
+        }
+    }
+
+    func testTyposStillMatch() {
+        let best = makeIndex().search("morty smth", limit: 1).first
+
+        XCTAssertEqual(best.map { FuzzyNameIndexTests.names[$0.id - 1] }, "Morty Smith")
+        XCTAssertEqual(best?.distance, 1)
+    }
+
+    func testRenamedEntriesAreSearchedByTheirNewName() {
+        let index = makeIndex()
+        index.insert(id: 1, name: "Doofus Rick")
+
+        XCTAssertEqual(index.count, FuzzyNameIndexTests.names.count)
+        XCTAssertEqual(index.search("doofus", limit: 5).map(\.id), [1])
+        var renamed = FuzzyNameIndexTests.names
+        renamed[0] = "Doofus Rick"
+        XCTAssertEqual(index.search("rick sanchez", limit: 1000),
+                       FuzzyNameIndexTests.bruteForceSearch("rick sanchez", names: renamed, limit: 1000))
+    }
+
+    func testPersistedIndexSearchesTheSame() throws {
+        let index = makeIndex()
+        let restored = try FuzzyNameIndex(data: index.encoded())
+
+        for query in FuzzyNameIndexTests.queries {
+            XCTAssertEqual(restored.search(query, limit: 20), index.search(query, limit: 20), query)
+        }
+    }
+}
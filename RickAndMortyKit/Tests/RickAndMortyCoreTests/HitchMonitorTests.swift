@@ -0,0 +1,115 @@
+//
+//  HitchMonitorTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class HitchMonitorTests: XCTestCase {
+    private let frame = 1.0 / 60
+
+    func testHistogramBuckets() {
+        var histogram = FrameTimeHistogram()
+        for milliseconds in [5, 8.4, 16.7, 16.8, 40, 300] {
+            histogram.record(milliseconds)
+        }
+
+        XCTAssertEqual(histogram.counts, [2, 1, 1, 0, 1, 0, 0, 1])
+        XCTAssertEqual(histogram.count, 6)
+        XCTAssertEqual(histogram.maximum, 300)
+    }
+
+    func testQuantilesAreBucketBoundsCappedAtTheLongestFrame() {
+        var histogram = FrameTimeHistogram()
+        XCTAssertEqual(histogram.quantile(0.99), 0)
+
+        for milliseconds in [5.0, 5, 5, 40] {
+            histogram.record(milliseconds)
+        }
+
+        XCTAssertEqual(histogram.quantile(0), 8.4)
+        XCTAssertEqual(histogram.quantile(0.5), 8.4)
+        XCTAssertEqual(histogram.quantile(0.75), 8.4)
+        XCTAssertEqual(histogram.quantile(1), 40)
+
+        histogram.record(400)
+        XCTAssertEqual(histogram.quantile(1), 400)
+    }
+
+    func testHitchesAreBlamedOnTheWorkThatOverlapsThem() {
+        let monitor = HitchMonitor()
+        monitor.record(.cellConfigure, start: 0.020, end: 0.030)
+        monitor.record(.imageDecode, start: 0.060, end: 0.080)
+        monitor.record(.diffApply, start: 0.100, end: 0.110)
+
+        monitor.recordFrame(start: 0, end: frame, expected: frame)
+        // 50 ms instead of 16.7: both the configure and the decode ran during it.
+        monitor.recordFrame(start: frame, end: frame + 0.050, expected: frame)
+        let report = monitor.takeReport()
+
+        XCTAssertEqual(report.frames, 2)
+        XCTAssertEqual(report.hitches, 1)
+        XCTAssertEqual(report.duration, frame + 0.050, accuracy: 1e-9)
+        XCTAssertEqual(report.hitchTime, (0.050 - frame) * 1000, accuracy: 1e-6)
+        XCTAssertEqual(report.attribution[.cellConfigure] ?? 0, report.hitchTime, accuracy: 1e-6)
+        XCTAssertEqual(report.attribution[.imageDecode] ?? 0, report.hitchTime, accuracy: 1e-6)
+        XCTAssertNil(report.attribution[.diffApply])
+        XCTAssertEqual(report.overlap[.cellConfigure] ?? 0, 10, accuracy: 1e-6)
+        XCTAssertEqual(report.overlap[.imageDecode] ?? 0, (frame + 0.050 - 0.060) * 1000, accuracy: 1e-6)
+        XCTAssertEqual(report.hitchTimeRatio, report.hitchTime / report.duration, accuracy: 1e-9)
+
+        XCTAssertEqual(monitor.takeReport(), HitchReport())
+    }
+
+    /// Work still running when a frame ends is blamed again if the next frame hitches too.
+    func testUnfinishedWorkCarriesOverToTheNextFrame() {
+        let monitor = HitchMonitor()
+        monitor.record(.imageDecode, start: 0.010, end: 0.060)
+
+        monitor.recordFrame(start: 0, end: 0.040, expected: frame)
+        monitor.recordFrame(start: 0.040, end: 0.080, expected: frame)
+        monitor.recordFrame(start: 0.080, end: 0.120, expected: frame)
+        let report = monitor.takeReport()
+
+        XCTAssertEqual(report.hitches, 3)
+        XCTAssertEqual(report.attribution[.imageDecode] ?? 0, 2 * (0.040 - frame) * 1000, accuracy: 1e-6)
+        XCTAssertEqual(report.overlap[.imageDecode] ?? 0, 50, accuracy: 1e-6)
+    }
+
+    func testOverrunsWithinToleranceAreNotHitches() {
+        let monitor = HitchMonitor()
+        monitor.tolerance = 0.002
+        monitor.record(.diffApply, start: 0, end: 0.010)
+        monitor.recordFrame(start: 0, end: frame + 0.0015, expected: frame)
+
+        let report = monitor.takeReport()
+        XCTAssertEqual(report.frames, 1)
+        XCTAssertEqual(report.hitches, 0)
+        XCTAssertTrue(report.attribution.isEmpty)
+    }
+
+    func testMeasuredWorkIsRecorded() {
+        let monitor = HitchMonitor()
+        let start = HitchMonitor.now
+        let value = monitor.measure(.cellConfigure) { 42 }
+        monitor.recordFrame(start: start - 1, end: HitchMonitor.now, expected: frame)
+
+        XCTAssertEqual(value, 42)
+        XCTAssertNotNil(monitor.takeReport().attribution[.cellConfigure])
+    }
+
+    func testResetDropsFramesAndIntervals() {
+        let monitor = HitchMonitor()
+        monitor.record(.imageDecode, start: 0, end: 1)
+        monitor.recordFrame(start: 0, end: 0.5, expected: frame)
+        monitor.reset()
+
+        monitor.recordFrame(start: 0.5, end: 0.9, expected: frame)
+        let report = monitor.takeReport()
+        XCTAssertEqual(report.frames, 1)
+        XCTAssertTrue(report.attribution.isEmpty)
+    }
+}
@@ -0,0 +1,112 @@
+//
+//  LazyCharacterTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+/// The byte scanner against `JSONDecoder` on the same pages.
+final class LazyCharacterTests: XCTestCase {
+    private func page(_ characters: [Character], options: JSONSerialization.WritingOptions = []) throws -> Data {
+        let results = try characters.map { try JSONSerialization.jsonObject(with: JSONEncoder().encode($0)) }
+        let info: [String: Any] = ["count": 826, "pages": 42, "next": "https://rickandmortyapi.com/api/character?page=2", "prev": NSNull()]
+        return try JSONSerialization.data(withJSONObject: ["info": info, "results": results], options: options)
+    }
+
+    private func assertListFields(_ lazy: [LazyCharacter], _ characters: [Character], file: StaticString = #filePath, line: UInt = #line) {
+        XCTAssertEqual(lazy.map(\.id), characters.map(\.id), file: file, line: line)
+        XCTAssertEqual(lazy.map(\.name), characters.map(\.name), file: file, line: line)
+        XCTAssertEqual(lazy.map(\.status), characters.map(\.status), file: file, line: line)
+        XCTAssertEqual(lazy.map(\.gender), characters.map(\.gender), file: file, line: line)
+        XCTAssertEqual(lazy.map(\.image), characters.map(\.image), file: file, line: line)
+        XCTAssertEqual(lazy.map(\.locationName), characters.map(\.location.name), file: file, line: line)
+    }
+
+    func testListFieldsAndRecordsMatchJSONDecoder() throws {
+        let characters = TestCharacters.catalogue(1...20)
+        for options: JSONSerialization.WritingOptions in [[], .prettyPrinted] {
+            let lazy = try LazyCharacter.decodePage(page(characters, options: options))
+
+            assertListFields(lazy, characters)
+            XCTAssertFalse(lazy[0].isDecoded)
+            XCTAssertEqualCharacters(try lazy.map { try $0.character() }, characters)
+            XCTAssertTrue(lazy[0].isDecoded)
+        }
+    }
+
+    func testEscapedStrings() throws {
+        let characters = [TestCharacters.character(id: 1, name: #"Rick "C-137" Sanchez"#),
+                          TestCharacters.character(id: 2, name: "Évil Morty \\ 🥒"),
+                          TestCharacters.character(id: 3, name: "Line\nbreak\tand tab")]
+        let lazy = try LazyCharacter.decodePage(page(characters))
+
+        assertListFields(lazy, characters)
+
+        let unicode = #"{"results": [{"id": 4, "name": "Évil \"Morty\"", "image": "a\/b"}]}"#
+        let escaped = try LazyCharacter.decodePage(Data(unicode.utf8))
+        XCTAssertEqual(escaped.map(\.name), [#"Évil "Morty""#])
+        XCTAssertEqual(escaped.map(\.image), ["a/b"])
+    }
+
+    /// Skipped fields may hold anything, including the characters the scanner counts.
+    func testSkippedValuesOfEveryKind() throws {
+        let json = """
+        {"info": {"next": null, "nested": [[1, 2], {"a": "]}"}], "ok": true, "ratio": -1.5e3},
+         "results": [
+           {"extra": {"quote": "\\"}", "list": ["{", "["]}, "id": 7, "name": "Squanchy",
+            "location": {"url": "", "name": "Squanch Planet", "dimension": null}, "status": "Alive",
+            "episode": [], "flag": false}
+         ],
+         "trailer": "}"}
+        """
+        let lazy = try LazyCharacter.decodePage(Data(json.utf8))
+
+        XCTAssertEqual(lazy.map(\.id), [7])
+        XCTAssertEqual(lazy.map(\.name), ["Squanchy"])
+        XCTAssertEqual(lazy.map(\.locationName), ["Squanch Planet"])
+        XCTAssertEqual(lazy.map(\.gender), [""])
+    }
+
+    func testEmptyResults() throws {
+        XCTAssertTrue(try LazyCharacter.decodePage(Data(#"{"info": {}, "results": []}"#.utf8)).isEmpty)
+        XCTAssertTrue(try LazyCharacter.decodePage(Data("{}".utf8)).isEmpty)
+    }
+
+    /// Records share the response's buffer, so a page sliced out of a larger buffer must work too.
+    func testPageSlicedOutOfALargerBuffer() throws {
+        let characters = TestCharacters.catalogue(21...30)
+        let padding = Data(repeating: UInt8(ascii: " "), count: 13)
+        let body = try page(characters)
+        let buffer = padding + body + padding
+        let slice = buffer[padding.count..<buffer.count - padding.count]
+
+        let lazy = try LazyCharacter.decodePage(slice)
+
+        assertListFields(lazy, characters)
+        XCTAssertEqualCharacters(try lazy.map { try $0.character() }, characters)
+    }
+
+    func testMalformedPagesThrow() throws {
+        let valid = try page(TestCharacters.catalogue(1...3))
+        let malformed = [
+            valid.prefix(valid.count / 2),
+            Data(#"{"results": [{"name": "No id"}]}"#.utf8),
+            Data(#"{"results": [{"id": 1}]}"#.utf8),
+            Data(#"{"results": [{"id": "1", "name": "String id"}]}"#.utf8),
+            Data(#"{"results": {"id": 1, "name": "Not an array"}}"#.utf8),
+            Data(#"{"results": [{"id": 1, "name": "Rick"} {"id": 2, "name": "Morty"}]}"#.utf8),
+            Data(#"{"results": [{"id": 1, "name": "Unterminated}]}"#.utf8),
+            Data()
+        ]
+        for data in malformed {
+            XCTAssertThrowsError(try LazyCharacter.decodePage(data), String(decoding: data, as: UTF8.self)) { error in
+                guard case .decode? = error as? ServiceError else {
+                    return XCTFail("\(error)")
+                }
+            }
+        }
+    }
+}
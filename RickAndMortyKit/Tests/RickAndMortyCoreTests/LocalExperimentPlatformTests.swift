@@ -0,0 +1,46 @@
+//
+//  LocalExperimentPlatformTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class LocalExperimentPlatformTests: XCTestCase {
+    private let metadata = ExperimentMetadata(enabledFeatureFlags: ["prefetch"])
+
+    private func waitForInitialization(of platform: LocalExperimentPlatform, timeout: TimeInterval) {
+        let initialized = expectation(description: "initialized")
+        let cancellable = platform.initialized.sink { initialized.fulfill() }
+        platform.start(applicationKey: "test", waitingForMetadataUpTo: timeout)
+        wait(for: [initialized], timeout: 2)
+        cancellable.cancel()
+    }
+
+    func testInitializesOnceMetadataArrives() {
+        let platform = LocalExperimentPlatform(metadata: metadata, metadataLatency: 0.05)
+        waitForInitialization(of: platform, timeout: 0)
+
+        XCTAssertTrue(platform.isMetadataAvailable)
+        XCTAssertTrue(platform.isFeatureFlagOn("prefetch"))
+    }
+
+    func testInitializesWithoutMetadataWhenTheServerNeverAnswers() {
+        let platform = LocalExperimentPlatform(metadata: metadata, metadataLatency: nil)
+        waitForInitialization(of: platform, timeout: 0)
+
+        XCTAssertFalse(platform.isMetadataAvailable)
+        XCTAssertFalse(platform.isFeatureFlagOn("prefetch"))
+    }
+
+    func testBlockingStartGivesUpAfterTheTimeout() {
+        let platform = LocalExperimentPlatform(metadata: metadata, metadataLatency: nil)
+        let start = Date()
+        waitForInitialization(of: platform, timeout: 0.1)
+
+        XCTAssertGreaterThanOrEqual(Date().timeIntervalSince(start), 0.1)
+        XCTAssertFalse(platform.isMetadataAvailable)
+    }
+}
@@ -0,0 +1,77 @@
+//
+//  MemoryCacheTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class MemoryCacheTests: XCTestCase {
+    func testLeastRecentlyUsedEntriesAreEvictedFirst() {
+        let cache = MemoryCache<Int, String>(countLimit: 2)
+        cache.setValue("Rick", forKey: 1)
+        cache.setValue("Morty", forKey: 2)
+        _ = cache.value(forKey: 1)
+        cache.setValue("Summer", forKey: 3)
+
+        XCTAssertEqual(cache.value(forKey: 1), "Rick")
+        XCTAssertNil(cache.value(forKey: 2))
+        XCTAssertEqual(cache.value(forKey: 3), "Summer")
+    }
+
+    func testCostLimitAndReplacedCosts() {
+        let cache = MemoryCache<Int, String>(costLimit: 10)
+        cache.setValue("Rick", forKey: 1, cost: 4)
+        cache.setValue("Morty", forKey: 2, cost: 4)
+        cache.setValue("Rick", forKey: 1, cost: 6)
+
+        XCTAssertEqual(cache.totalCost, 10)
+        cache.setValue("Summer", forKey: 3, cost: 4)
+
+        XCTAssertNil(cache.value(forKey: 2))
+        XCTAssertEqual(cache.count, 2)
+        XCTAssertEqual(cache.totalCost, 10)
+    }
+
+    func testTrimToCostKeepsTheNewestEntries() {
+        let cache = MemoryCache<Int, Int>()
+        for key in 0..<10 {
+            cache.setValue(key, forKey: key, cost: 1)
+        }
+        cache.trim(toCost: 3)
+
+        XCTAssertEqual((0..<10).compactMap { cache.value(forKey: $0) }, [7, 8, 9])
+    }
+
+    /// Dropping a long list at once must not release its nodes recursively and overflow the stack.
+    func testEvictingHundredThousandEntries() {
+        let count = 100_000
+        let cache = MemoryCache<Int, Int>()
+        for key in 0..<count {
+            cache.setValue(key, forKey: key, cost: 1)
+        }
+        cache.trim(toCount: 0)
+
+        XCTAssertEqual(cache.count, 0)
+        XCTAssertEqual(cache.totalCost, 0)
+
+        for key in 0..<count {
+            cache.setValue(key, forKey: key)
+        }
+        cache.removeAll()
+        XCTAssertEqual(cache.count, 0)
+    }
+
+    func testReleasingAFullCache() {
+        var cache: MemoryCache<Int, Int>? = MemoryCache()
+        for key in 0..<100_000 {
+            cache?.setValue(key, forKey: key)
+        }
+        weak var released = cache
+        cache = nil
+
+        XCTAssertNil(released)
+    }
+}
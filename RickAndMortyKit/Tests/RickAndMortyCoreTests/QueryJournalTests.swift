@@ -0,0 +1,65 @@
+//
+//  QueryJournalTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class QueryJournalTests: XCTestCase {
+    private let start = Date(timeIntervalSinceReferenceDate: 0)
+
+    func testPendingQueriesCoalesceKeystrokesAndDuplicates() {
+        let journal = QueryJournal(fileURL: nil)
+        journal.record("name=r", at: start)
+        journal.record("name=ri", at: start + 0.3)
+        journal.record("name=rick", at: start + 0.6)
+        journal.record("name=morty", at: start + 10)
+        journal.record("Name=Rick ", at: start + 20)
+
+        XCTAssertEqual(journal.pendingQueries(), ["name=rick", "name=morty"])
+    }
+
+    /// A prefix searched long before the longer query was a search of its own.
+    func testPrefixesOutsideTheTypingWindowAreKept() {
+        let journal = QueryJournal(fileURL: nil)
+        journal.record("name=rick", at: start)
+        journal.record("name=rick sanchez", at: start + QueryJournal.typingWindow + 1)
+
+        XCTAssertEqual(journal.pendingQueries(), ["name=rick", "name=rick sanchez"])
+    }
+
+    func testMarkSyncedOnlyCoversEntriesUpToTheDate() {
+        let journal = QueryJournal(fileURL: nil)
+        journal.record("name=rick", at: start)
+        journal.record("name=morty", at: start + 10)
+
+        journal.markSynced(through: start + 5)
+
+        XCTAssertEqual(journal.pendingQueries(), ["name=morty"])
+    }
+
+    func testOldestEntriesAreDroppedPastTheMaximum() {
+        let journal = QueryJournal(fileURL: nil, maximumEntries: 2)
+        for (index, name) in ["rick", "morty", "summer"].enumerated() {
+            journal.record("name=\(name)", at: start + Double(index) * 10)
+        }
+
+        XCTAssertEqual(journal.pendingQueries(), ["name=morty", "name=summer"])
+    }
+
+    func testJournalIsReplayedAfterRelaunch() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let fileURL = directory.appendingPathComponent("query-journal.json")
+
+        let journal = QueryJournal(fileURL: fileURL)
+        journal.record("name=rick", at: start)
+        journal.record("name=morty", at: start + 10)
+        journal.markSynced(through: start + 5)
+
+        XCTAssertEqual(QueryJournal(fileURL: fileURL).pendingQueries(), ["name=morty"])
+    }
+}
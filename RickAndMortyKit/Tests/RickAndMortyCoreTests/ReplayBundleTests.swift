@@ -0,0 +1,116 @@
+//
+//  ReplayBundleTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+@testable import RickAndMortyCore
+
+final class ReplayBundleTests: XCTestCase {
+    private var directory: URL!
+
+    override func setUp() {
+        super.setUp()
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    private func request(_ url: String, method: String = "GET", body: String? = nil) -> URLRequest {
+        var request = URLRequest(url: URL(string: url)!)
+        request.httpMethod = method
+        request.httpBody = body.map { Data($0.utf8) }
+        return request
+    }
+
+    private func response(to request: URLRequest, status: Int = 200) -> HTTPURLResponse {
+        return HTTPURLResponse(url: request.url!, statusCode: status, httpVersion: "HTTP/1.1",
+                               headerFields: ["Content-Type": "application/json"])!
+    }
+
+    private func body(_ bundle: ReplayBundle, _ request: URLRequest) -> String? {
+        return bundle.response(to: request).map { String(decoding: $0.body, as: UTF8.self) }
+    }
+
+    func testHashIsFNV1a() {
+        XCTAssertEqual(ReplayBundle.hash(of: Data()), "cbf29ce484222325")
+        XCTAssertEqual(ReplayBundle.hash(of: Data("a".utf8)), "af63dc4c8601ec8c")
+        XCTAssertEqual(ReplayBundle.hash(of: Data("foobar".utf8)), "85944171f73967e8")
+    }
+
+    func testRoutesMatchPathQueryMethodAndHost() {
+        let route = ReplayBundle.Route(path: "/api/character", query: "page=2", fixture: "character-page-2.json")
+        let hosted = ReplayBundle.Route(path: "/api/character", query: "page=2", fixture: "character-page-2.json",
+                                        host: "rickandmortyapi.com")
+
+        XCTAssertTrue(route.matches(request("https://rickandmortyapi.com/api/character?page=2"), bodyHash: nil))
+        XCTAssertTrue(route.matches(request("http://localhost:8080/api/character?page=2"), bodyHash: nil))
+        XCTAssertFalse(hosted.matches(request("http://localhost:8080/api/character?page=2"), bodyHash: nil))
+        XCTAssertFalse(route.matches(request("https://rickandmortyapi.com/api/character?page=3"), bodyHash: nil))
+        XCTAssertFalse(route.matches(request("https://rickandmortyapi.com/api/character"), bodyHash: nil))
+        XCTAssertFalse(route.matches(request("https://rickandmortyapi.com/api/character?page=2", method: "POST"), bodyHash: nil))
+    }
+
+    func testBodyHashesTellPostsToOnePathApart() {
+        let rick = request("https://rickandmortyapi.com/graphql", method: "POST", body: #"{"query":"rick"}"#)
+        let morty = request("https://rickandmortyapi.com/graphql", method: "POST", body: #"{"query":"morty"}"#)
+        let route = ReplayBundle.Route(path: "/graphql", query: nil, fixture: "rick.json", method: "POST",
+                                       bodyHash: ReplayBundle.bodyHash(of: rick))
+        let anyBody = ReplayBundle.Route(path: "/graphql", query: nil, fixture: "any.json", method: "POST")
+
+        XCTAssertTrue(route.matches(rick, bodyHash: ReplayBundle.bodyHash(of: rick)))
+        XCTAssertFalse(route.matches(morty, bodyHash: ReplayBundle.bodyHash(of: morty)))
+        XCTAssertTrue(anyBody.matches(morty, bodyHash: ReplayBundle.bodyHash(of: morty)))
+        XCTAssertNil(ReplayBundle.bodyHash(of: request("https://rickandmortyapi.com/api/character", body: "ignored")))
+    }
+
+    func testStreamedBodiesAreReadIntoTheRequest() {
+        let data = Data((0..<40_000).map { UInt8($0 % 251) })
+        var streamed = request("https://rickandmortyapi.com/graphql", method: "POST")
+        streamed.httpBodyStream = InputStream(data: data)
+
+        let read = ReplayBundle.withBodyData(streamed)
+
+        XCTAssertEqual(read.httpBody, data)
+        XCTAssertEqual(ReplayBundle.bodyHash(of: read), ReplayBundle.hash(of: data))
+    }
+
+    func testRecordedResponsesReplay() throws {
+        let page = request("https://rickandmortyapi.com/api/character?page=2")
+        let rick = request("https://rickandmortyapi.com/graphql", method: "POST", body: #"{"query":"rick"}"#)
+        let morty = request("https://rickandmortyapi.com/graphql", method: "POST", body: #"{"query":"morty"}"#)
+        let missing = request("https://rickandmortyapi.com/api/character/9999")
+
+        let recorder = try ReplayRecorder(directory: directory)
+        try recorder.record(page, response: response(to: page), body: Data("page 2".utf8))
+        try recorder.record(rick, response: response(to: rick), body: Data("rick".utf8))
+        try recorder.record(morty, response: response(to: morty), body: Data("morty".utf8))
+        try recorder.record(missing, response: response(to: missing, status: 404), body: Data("not found".utf8))
+        // Already recorded: the first answer is kept.
+        try recorder.record(rick, response: response(to: rick), body: Data("rick again".utf8))
+
+        XCTAssertEqual(recorder.routes.count, 4)
+        XCTAssertEqual(recorder.routes.first?.fixture, "character-page-2.json")
+        XCTAssertEqual(recorder.routes[1].fixture, "post-graphql-\(ReplayBundle.hash(of: rick.httpBody!).prefix(8)).json")
+
+        let bundle = try ReplayBundle(directory: directory)
+        XCTAssertEqual(body(bundle, page), "page 2")
+        XCTAssertEqual(body(bundle, rick), "rick")
+        XCTAssertEqual(body(bundle, morty), "morty")
+        XCTAssertEqual(bundle.response(to: missing)?.response.statusCode, 404)
+        XCTAssertNil(bundle.response(to: request("https://rickandmortyapi.com/graphql", method: "POST", body: "{}")))
+        XCTAssertNil(bundle.response(to: request("https://rickandmortyapi.com/api/character?page=3")))
+
+        // Reopening a recording extends it.
+        let reopened = try ReplayRecorder(directory: directory)
+        XCTAssertEqual(reopened.routes, recorder.routes)
+    }
+}
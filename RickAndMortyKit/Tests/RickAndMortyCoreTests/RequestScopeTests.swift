@@ -0,0 +1,88 @@
+//
+//  RequestScopeTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class RequestScopeTests: XCTestCase {
+    private let scope = RequestScope<String>()
+    private var cancellations = [String: Int]()
+
+    /// Starts `subject` as the request for `intent`, counting its cancellations.
+    private func start(_ intent: String, _ subject: PassthroughSubject<Int, Never>) {
+        scope.start(intent) { finished in
+            subject
+                .handleEvents(receiveCancel: { self.cancellations[intent, default: 0] += 1 })
+                .sink(receiveCompletion: { _ in finished() }, receiveValue: { _ in })
+        }
+    }
+
+    func testStartingAnIntentAgainCancelsTheRequestItSupersedes() {
+        let first = PassthroughSubject<Int, Never>()
+        let second = PassthroughSubject<Int, Never>()
+        start("page=2", first)
+        start("page=2", second)
+
+        XCTAssertEqual(cancellations["page=2"], 1)
+        XCTAssertEqual(scope.count, 1)
+
+        // The superseded request finishing late must not free the new one's slot.
+        first.send(completion: .finished)
+        XCTAssertTrue(scope.isActive("page=2"))
+
+        second.send(completion: .finished)
+        XCTAssertFalse(scope.isActive("page=2"))
+        XCTAssertEqual(cancellations["page=2"], 1)
+    }
+
+    func testIntentsRunSideBySide() {
+        let page = PassthroughSubject<Int, Never>()
+        let search = PassthroughSubject<Int, Never>()
+        start("page=2", page)
+        start("name=rick", search)
+
+        XCTAssertEqual(scope.count, 2)
+
+        scope.cancel("name=rick")
+        XCTAssertEqual(cancellations["name=rick"], 1)
+        XCTAssertNil(cancellations["page=2"])
+        XCTAssertEqual(scope.count, 1)
+
+        scope.cancelAll()
+        XCTAssertEqual(cancellations["page=2"], 1)
+        XCTAssertEqual(scope.count, 0)
+    }
+
+    func testRequestsFinishingBeforeStartReturnsAreNotKept() {
+        scope.start("page=1") { finished in
+            Just(1).sink(receiveCompletion: { _ in finished() }, receiveValue: { _ in })
+        }
+
+        XCTAssertEqual(scope.count, 0)
+    }
+
+    func testRepeatedLoadsKeepOneSubscription() {
+        let ledger = SubscriptionLedger()
+        var subjects = [PassthroughSubject<Int, Never>]()
+        for _ in 0..<1_000 {
+            let subject = PassthroughSubject<Int, Never>()
+            subjects.append(subject)
+            scope.start("page=1") { finished in
+                subject
+                    .tracked(as: "page", in: ledger)
+                    .sink(receiveCompletion: { _ in finished() }, receiveValue: { _ in })
+            }
+        }
+
+        XCTAssertEqual(ledger.count("page"), 1)
+        XCTAssertEqual(ledger.peak("page"), 1)
+
+        subjects.last?.send(completion: .finished)
+        XCTAssertEqual(ledger.total, 0)
+        XCTAssertEqual(scope.count, 0)
+    }
+}
@@ -0,0 +1,57 @@
+//
+//  RowHeightCacheTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class RowHeightCacheTests: XCTestCase {
+    private let large = "UICTContentSizeCategoryL"
+    private let extraLarge = "UICTContentSizeCategoryXL"
+
+    func testHeightsAreKeptPerCategory() {
+        let cache = RowHeightCache()
+        cache.setHeight(440, forID: 1, category: large)
+        cache.setHeight(470, forID: 1, category: extraLarge)
+
+        XCTAssertEqual(cache.height(forID: 1, category: large), 440)
+        XCTAssertEqual(cache.height(forID: 1, category: extraLarge), 470)
+        XCTAssertNil(cache.height(forID: 2, category: large))
+        XCTAssertEqual(cache.count, 2)
+    }
+
+    func testAverageHeightIsTheMeanOfTheCategory() {
+        let cache = RowHeightCache()
+        XCTAssertNil(cache.averageHeight(category: large))
+
+        cache.setHeight(400, forID: 1, category: large)
+        cache.setHeight(500, forID: 2, category: large)
+        cache.setHeight(900, forID: 1, category: extraLarge)
+
+        XCTAssertEqual(cache.averageHeight(category: large), 450)
+        XCTAssertEqual(cache.averageHeight(category: extraLarge), 900)
+    }
+
+    func testMeasuringARowAgainReplacesItsHeight() {
+        let cache = RowHeightCache()
+        cache.setHeight(400, forID: 1, category: large)
+        cache.setHeight(500, forID: 2, category: large)
+        cache.setHeight(600, forID: 1, category: large)
+        cache.setHeight(600, forID: 1, category: large)
+
+        XCTAssertEqual(cache.height(forID: 1, category: large), 600)
+        XCTAssertEqual(cache.averageHeight(category: large), 550)
+    }
+
+    func testRemoveAllForgetsTheAverages() {
+        let cache = RowHeightCache()
+        cache.setHeight(400, forID: 1, category: large)
+        cache.removeAll()
+
+        XCTAssertEqual(cache.count, 0)
+        XCTAssertNil(cache.averageHeight(category: large))
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  SubscriptionLedgerTests.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import XCTest
+@testable import RickAndMortyCore
+
+final class SubscriptionLedgerTests: XCTestCase {
+    private let ledger = SubscriptionLedger()
+
+    func testSubscriptionsAreCountedUntilTheyComplete() {
+        let subject = PassthroughSubject<Int, Error>()
+        let publisher = subject.tracked(as: "characters", in: ledger)
+
+        XCTAssertEqual(ledger.count("characters"), 0, "counted before subscribing")
+
+        let first = publisher.sink(receiveCompletion: { _ in }, receiveValue: { _ in })
+        let second = publisher.sink(receiveCompletion: { _ in }, receiveValue: { _ in })
+        XCTAssertEqual(ledger.count("characters"), 2)
+
+        subject.send(completion: .failure(ServiceError.urlRequest))
+        XCTAssertEqual(ledger.count("characters"), 0)
+        XCTAssertEqual(ledger.peak("characters"), 2)
+
+        // Cancelling after completion does not count twice.
+        first.cancel()
+        second.cancel()
+        XCTAssertEqual(ledger.count("characters"), 0)
+    }
+
+    func testCancelledSubscriptionsAreReleased() {
+        let cancellable = PassthroughSubject<Int, Never>()
+            .tracked(as: "search", in: ledger)
+            .sink { _ in }
+        let other = PassthroughSubject<Int, Never>()
+            .tracked(as: "episodes", in: ledger)
+            .sink { _ in }
+
+        XCTAssertEqual(ledger.total, 2)
+
+        cancellable.cancel()
+        XCTAssertEqual(ledger.count("search"), 0)
+        XCTAssertEqual(ledger.count("episodes"), 1)
+        withExtendedLifetime(other) {}
+    }
+
+    func testResetPeaksStartsFromTheLiveCounts() {
+        let subjects = (0..<3).map { _ in PassthroughSubject<Int, Never>() }
+        let cancellables = subjects.map { $0.tracked(as: "page", in: ledger).sink { _ in } }
+        subjects[0].send(completion: .finished)
+        subjects[1].send(completion: .finished)
+
+        XCTAssertEqual(ledger.peak("page"), 3)
+        ledger.resetPeaks()
+        XCTAssertEqual(ledger.peak("page"), 1)
+        withExtendedLifetime(cancellables) {}
+    }
+
+    func testConcurrentSubscriptionsBalance() {
+        DispatchQueue.concurrentPerform(iterations: 1_000) { index in
+            let cancellable = Just(index).tracked(as: "concurrent", in: ledger).sink { _ in }
+            cancellable.cancel()
+        }
+
+        XCTAssertEqual(ledger.count("concurrent"), 0)
+        XCTAssertGreaterThanOrEqual(ledger.peak("concurrent"), 1)
+    }
+}
@@ -0,0 +1,50 @@
+//
+//  TestCharacters.swift
+//  RickAndMortyCoreTests
+//
+//  Created by agent on 19/10/26.
+//
+
+import Foundation
+import XCTest
+@testable import RickAndMortyCore
+
+/// Characters with every kind of field the snapshot has to keep: shared strings, a missing origin
+/// url, non-ASCII names, no episodes or several.
+enum TestCharacters {
+    static let names = ["Rick Sanchez", "Morty Smith", "Summer Smith", "Beth Smith", "Jerry Smith",
+                        "Abradolf Lincler", "Birdperson", "Squanchy", "Mr. Poopybutthole", "Évil Morty",
+                        "Noob-Noob", "Unity", "Krombopulos Michael", "Scary Terry", "Tammy Guetermann"]
+
+    static func character(id: Int, name: String? = nil) -> Character {
+        let episodes = (0..<(id % 4)).map { "https://rickandmortyapi.com/api/episode/\(id + $0)" }
+        return Character(id: id,
+                         name: name ?? "\(names[id % names.count]) \(id)",
+                         status: ["Alive", "Dead", "unknown"][id % 3],
+                         species: id % 5 == 0 ? "Alien" : "Human",
+                         type: id % 7 == 0 ? "Parasite" : "",
+                         gender: id % 2 == 0 ? "Female" : "Male",
+                         origin: Location(name: "Earth (C-137)", url: id % 3 == 0 ? nil : "https://rickandmortyapi.com/api/location/1"),
+                         location: Location(name: id % 6 == 0 ? nil : "Citadel of Ricks", url: "https://rickandmortyapi.com/api/location/3"),
+                         image: "https://rickandmortyapi.com/api/character/avatar/\(id).jpeg",
+                         episode: episodes,
+                         url: "https://rickandmortyapi.com/api/character/\(id)",
+                         created: "2017-11-04T18:48:46.250Z")
+    }
+
+    static func catalogue(_ ids: ClosedRange<Int>) -> [Character] {
+        return ids.map { character(id: $0) }
+    }
+}
+
+/// Compares characters as JSON with sorted keys, so a failure shows which fields differ.
+func XCTAssertEqualCharacters(_ lhs: [Character], _ rhs: [Character], file: StaticString = #filePath, line: UInt = #line) {
+    let encoder = JSONEncoder()
+    encoder.outputFormatting = .sortedKeys
+    XCTAssertEqual(lhs.count, rhs.count, "character count", file: file, line: line)
+    for (left, right) in zip(lhs, rhs) {
+        XCTAssertEqual(String(decoding: try! encoder.encode(left), as: UTF8.self),
+                       String(decoding: try! encoder.encode(right), as: UTF8.self),
+                       file: file, line: line)
+    }
+}